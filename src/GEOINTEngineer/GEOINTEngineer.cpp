@@ -11,14 +11,21 @@
 //
 
 #include "GEOINTEngineer.h"
+#include "GeospatialJobScheduler.h"
 #include "GeospatialTaskListModel.h"
+#include "GeospatialTaskParameterModel.h"
 #include "LocalGeospatialServer.h"
 #include "LocalGeospatialTask.h"
+#include "MapPackageListModel.h"
 #include "MapViewTool.h"
 
 #include "ArcGISMapImageLayer.h"
+#include "ArcGISTiledLayer.h"
+#include "ArcGISVectorTiledLayer.h"
 #include "Basemap.h"
+#include "CoreTypes.h"
 #include "Envelope.h"
+#include "Error.h"
 #include "Feature.h"
 #include "FeatureCollection.h"
 #include "FeatureCollectionLayer.h"
@@ -30,6 +37,8 @@
 #include "GeoprocessingFeatures.h"
 #include "GeoprocessingResult.h"
 #include "GeoprocessingTypes.h"
+#include "GroupLayer.h"
+#include "Layer.h"
 #include "LayerListModel.h"
 #include "Map.h"
 #include "MapQuickView.h"
@@ -42,8 +51,14 @@
 #include "SpatialReference.h"
 #include "SymbolTypes.h"
 #include "TaskWatcher.h"
+#include "TileCache.h"
+#include "VectorTileCache.h"
 #include "Viewpoint.h"
 
+#include <QDir>
+#include <QFileInfo>
+#include <QProcessEnvironment>
+#include <QTimer>
 #include <QUrl>
 
 #include <memory>
@@ -52,24 +67,123 @@ using namespace Esri::ArcGISRuntime;
 
 GEOINTEngineer::GEOINTEngineer(QObject *parent /* = nullptr */):
     QObject(parent),
-    m_map(new Map(BasemapStyle::OsmStandard, this)),
+    m_map(createMap()),
     m_inputFeatureLayer(new FeatureCollectionLayer(new FeatureCollection(this), this)),
-    m_localGeospatialServer(new LocalGeospatialServer(this)),
+    m_localGeospatialServer(LocalGeospatialServer::instance()),
+    m_mapPackageListModel(new MapPackageListModel(this)),
     m_operationalLayerInitialized(false),
     m_polygonSketchTool(new PolygonSketchTool(this))
 {
-    connect(m_localGeospatialServer, &LocalGeospatialServer::mapLoaded, this, &GEOINTEngineer::onMapLoaded);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::mobileMapPackageAdded, m_mapPackageListModel, &MapPackageListModel::addPackage);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::mobileMapPackageRemoved, m_mapPackageListModel, &MapPackageListModel::removePackage);
+    connect(m_mapPackageListModel, &MapPackageListModel::mapSelected, this, &GEOINTEngineer::onMapLoaded);
     connect(m_localGeospatialServer, &LocalGeospatialServer::mapServiceLoaded, this, &GEOINTEngineer::onMapServiceLoaded);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::mapServiceRemoved, this, &GEOINTEngineer::onMapServiceRemoved);
     connect(m_localGeospatialServer, &LocalGeospatialServer::taskLoaded, this, &GEOINTEngineer::onTaskLoaded);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::taskRemoved, this, &GEOINTEngineer::onTaskRemoved);
     connect(m_localGeospatialServer, &LocalGeospatialServer::taskCompleted, this, &GEOINTEngineer::onTaskCompleted);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::sweepCompleted, this, &GEOINTEngineer::onSweepCompleted);
+    connect(m_localGeospatialServer, &LocalGeospatialServer::timeWindowCompleted, this, &GEOINTEngineer::onTimeWindowCompleted);
 
     connect(m_polygonSketchTool, &PolygonSketchTool::polygonConstructed, this, &GEOINTEngineer::onPolygonConstructed);
+
+    // The selected task starts as soon as a new input area was added
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString speculativeKeyName = "geoint.jobs.speculative";
+    if (systemEnvironment.contains(speculativeKeyName))
+    {
+        m_speculativeExecutionEnabled = (0 == systemEnvironment.value(speculativeKeyName).compare("true", Qt::CaseInsensitive));
+    }
+
+    foreach (QString const &packageFilePath, m_localGeospatialServer->mobileMapPackageFilePaths())
+    {
+        m_mapPackageListModel->addPackage(packageFilePath);
+    }
+
+    // The local server is started before the QML engine is loaded,
+    // the tasks known so far are offered as soon as the QML handlers are connected
+    QList<LocalGeospatialTask*> knownTasks = m_localGeospatialServer->tasks();
+    QTimer::singleShot(0, this, [this, knownTasks]()
+    {
+        foreach (LocalGeospatialTask *geospatialTask, knownTasks)
+        {
+            emit taskLoaded(geospatialTask);
+        }
+    });
 }
 
 GEOINTEngineer::~GEOINTEngineer()
 {
 }
 
+Map* GEOINTEngineer::createMap()
+{
+    // A local tile or vector tile package is preferred over the online basemap
+    QString basemapFilePath;
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString basemapKeyName = "geoint.basemap";
+    QString dataPathKeyName = "geoint.datapath";
+    if (systemEnvironment.contains(basemapKeyName))
+    {
+        basemapFilePath = systemEnvironment.value(basemapKeyName);
+    }
+    else if (systemEnvironment.contains(dataPathKeyName))
+    {
+        QDir dataDirectory(systemEnvironment.value(dataPathKeyName));
+        QFileInfoList basemapFiles = dataDirectory.entryInfoList(QStringList() << "*.tpkx" << "*.tpk" << "*.vtpk", QDir::Files, QDir::Name);
+        if (!basemapFiles.isEmpty())
+        {
+            basemapFilePath = basemapFiles.first().absoluteFilePath();
+        }
+    }
+
+    if (!basemapFilePath.isEmpty() && QFileInfo::exists(basemapFilePath))
+    {
+        qDebug() << "Using local basemap" << basemapFilePath;
+        Layer *basemapLayer = nullptr;
+        if (basemapFilePath.endsWith(".vtpk", Qt::CaseInsensitive))
+        {
+            basemapLayer = new ArcGISVectorTiledLayer(new VectorTileCache(basemapFilePath, this), this);
+        }
+        else
+        {
+            basemapLayer = new ArcGISTiledLayer(new TileCache(basemapFilePath, this), this);
+        }
+        return new Map(new Basemap(basemapLayer, this), this);
+    }
+
+    // Air-gapped machines must not wait for the online basemap
+    QString offlineKeyName = "geoint.offline";
+    if (systemEnvironment.contains(offlineKeyName)
+            && 0 == systemEnvironment.value(offlineKeyName).compare("true", Qt::CaseInsensitive))
+    {
+        qDebug() << "No local basemap found, using an empty map.";
+        return new Map(SpatialReference::webMercator(), this);
+    }
+
+    return new Map(BasemapStyle::OsmStandard, this);
+}
+
+MapPackageListModel* GEOINTEngineer::mapPackages() const
+{
+    return m_mapPackageListModel;
+}
+
+GeospatialJobScheduler* GEOINTEngineer::jobScheduler() const
+{
+    return m_localGeospatialServer->jobScheduler();
+}
+
+QStringList GEOINTEngineer::pipelineNames() const
+{
+    return m_localGeospatialServer->pipelineNames();
+}
+
+void GEOINTEngineer::selectMapPackage(int packageIndex)
+{
+    m_mapPackageListModel->selectPackage(packageIndex);
+}
+
 MapQuickView* GEOINTEngineer::mapView() const
 {
     return m_mapView;
@@ -91,17 +205,6 @@ void GEOINTEngineer::setMapView(MapQuickView *mapView)
     connect(m_mapView, &MapQuickView::mouseReleased, this, &GEOINTEngineer::onMouseReleased);
 
     emit mapViewChanged();
-
-    // Start the local server instance
-    switch (m_localGeospatialServer->start())
-    {
-    case LocalGeospatialServer::Status::Failed:
-        qDebug() << "Local geospatial server could not be started!";
-        break;
-
-    default:
-        break;
-    }
 }
 
 void GEOINTEngineer::initOperationalLayers()
@@ -136,6 +239,9 @@ void GEOINTEngineer::deleteAllInputFeatures()
         return;
     }
 
+    // Without an input area the results of the next execution are not cached
+    m_inputPolygon = Polygon();
+    supersedeInputs();
     m_deletePostAction = DeletePostAction::None;
     QueryParameters allFeaturesQuery;
     allFeaturesQuery.setWhereClause("1=1");
@@ -144,17 +250,32 @@ void GEOINTEngineer::deleteAllInputFeatures()
 
 void GEOINTEngineer::deleteAllOutputFeatures()
 {
-    QList<ArcGISMapImageLayer*> outputLayers;
-    for(Layer *operationalLayer : *m_map->operationalLayers())
+    QList<Layer*> outputLayers;
+    LayerListModel *operationalLayers = m_map->operationalLayers();
+    for (int layerIndex = 0; layerIndex < operationalLayers->size(); layerIndex++)
     {
-        ArcGISMapImageLayer *mapImageLayer = dynamic_cast<ArcGISMapImageLayer*>(operationalLayer);
-        if (nullptr != mapImageLayer)
+        Layer *operationalLayer = operationalLayers->at(layerIndex);
+        if (nullptr != dynamic_cast<ArcGISMapImageLayer*>(operationalLayer))
         {
-            outputLayers.append(mapImageLayer);
+            outputLayers.append(operationalLayer);
+            continue;
+        }
+
+        // Sweeps, time windows, cached and tiled results are added on top of the layers of the map
+        if (layerIndex < m_mapLayerCount
+                || m_inputFeatureLayer == operationalLayer
+                || m_outputFeatureLayer == operationalLayer)
+        {
+            continue;
+        }
+        if (nullptr != dynamic_cast<GroupLayer*>(operationalLayer)
+                || nullptr != dynamic_cast<FeatureCollectionLayer*>(operationalLayer))
+        {
+            outputLayers.append(operationalLayer);
         }
     }
 
-    foreach (ArcGISMapImageLayer *outputLayer, outputLayers)
+    foreach (Layer *outputLayer, outputLayers)
     {
         m_map->operationalLayers()->removeOne(outputLayer);
         delete outputLayer;
@@ -207,6 +328,7 @@ void GEOINTEngineer::addMapExtentAsGraphic()
     polygonBuilder->addPoint(boundingBox.xMax(), boundingBox.yMax());
     polygonBuilder->addPoint(boundingBox.xMax(), boundingBox.yMin());
     m_inputPolygon = polygonBuilder->toPolygon();
+    supersedeInputs();
 
     // First of all delete all input features
     // when delete all was executed, the current map extent
@@ -233,7 +355,7 @@ void GEOINTEngineer::deactivateMapTool()
     m_currentTool = nullptr;
 }
 
-void GEOINTEngineer::executeTask(GeospatialTaskListModel *taskModel, int taskIndex)
+void GEOINTEngineer::executeTask(GeospatialTaskListModel *taskModel, int taskIndex, GeospatialTaskParameterModel *parameterModel)
 {
     m_geospatialTaskListModel = taskModel;
 
@@ -246,9 +368,76 @@ void GEOINTEngineer::executeTask(GeospatialTaskListModel *taskModel, int taskInd
         return;
     }
 
+    // The speculative execution used the default parameters
+    QList<GeospatialParameterSweep> parameterValues;
+    QList<GeospatialTimeWindows> dateValues;
+    if (nullptr != parameterModel)
+    {
+        parameterValues = parameterModel->parameterValues();
+        dateValues = parameterModel->dateValues();
+    }
+    if (parameterValues.isEmpty()
+            && dateValues.isEmpty()
+            && adoptSpeculativeExecution(m_currentGeospatialTask))
+    {
+        return;
+    }
+    discardSpeculativeExecution();
+
     qDebug() << "Executing " << m_currentGeospatialTask->displayName() << " using the input features...";
     GeoprocessingFeatures* mapExtentAsFeatures = new GeoprocessingFeatures(m_inputFeatures, this);
-    m_localGeospatialServer->executeTask(m_currentGeospatialTask, mapExtentAsFeatures);
+    GeospatialTaskContext taskContext = GeospatialTaskContext::create(mapExtentAsFeatures, m_inputPolygon, m_inputVersion);
+
+    // Entered values override the defaults, the first parameter with several values is swept
+    GeospatialParameterSweep parameterSweep;
+    foreach (GeospatialParameterSweep const &parameterValue, parameterValues)
+    {
+        if (parameterValue.isSweep()
+                && !parameterSweep.isSweep())
+        {
+            parameterSweep = parameterValue;
+            continue;
+        }
+
+        taskContext.parameterOverrides.insert(parameterValue.parameterName, parameterValue.createParameter(parameterValue.values.first(), mapExtentAsFeatures));
+    }
+
+    // A date range split into windows takes precedence over a sweep, the sweep then uses its first value
+    GeospatialTimeWindows timeSlices;
+    foreach (GeospatialTimeWindows const &dateValue, dateValues)
+    {
+        if (dateValue.isSliced()
+                && !timeSlices.isSliced())
+        {
+            timeSlices = dateValue;
+            continue;
+        }
+
+        QMap<QString, GeoprocessingParameter*> dateParameters = dateValue.createParameters(dateValue.windows().first(), mapExtentAsFeatures);
+        for (auto dateIterator = dateParameters.constBegin(); dateIterator != dateParameters.constEnd(); ++dateIterator)
+        {
+            taskContext.parameterOverrides.insert(dateIterator.key(), dateIterator.value());
+        }
+    }
+
+    QUuid requestId;
+    if (timeSlices.isSliced())
+    {
+        if (parameterSweep.isSweep())
+        {
+            taskContext.parameterOverrides.insert(parameterSweep.parameterName, parameterSweep.createParameter(parameterSweep.values.first(), mapExtentAsFeatures));
+        }
+        requestId = m_localGeospatialServer->executeTimeSlices(m_currentGeospatialTask, taskContext, timeSlices);
+    }
+    else if (parameterSweep.isSweep())
+    {
+        requestId = m_localGeospatialServer->executeSweep(m_currentGeospatialTask, taskContext, parameterSweep);
+    }
+    else
+    {
+        requestId = m_localGeospatialServer->executeTask(m_currentGeospatialTask, taskContext);
+    }
+    qDebug() << "Execution request" << requestId << "submitted.";
 }
 
 void GEOINTEngineer::executeAllTasks(GeospatialTaskListModel *taskModel)
@@ -266,7 +455,150 @@ void GEOINTEngineer::executeAllTasks(GeospatialTaskListModel *taskModel)
 
     qDebug() << "Executing all tasks using the input features...";
     GeoprocessingFeatures* mapExtentAsFeatures = new GeoprocessingFeatures(m_inputFeatures, this);
-    m_localGeospatialServer->executeTasks(mapExtentAsFeatures);
+    m_localGeospatialServer->executeTasks(mapExtentAsFeatures, m_inputPolygon, m_inputVersion);
+}
+
+void GEOINTEngineer::executePipeline(QString const &pipelineName)
+{
+    if (!m_operationalLayerInitialized)
+    {
+        qDebug() << "Operational input layers were not initialized!";
+        return;
+    }
+
+    qDebug() << "Executing pipeline" << pipelineName << "using the input features...";
+    GeoprocessingFeatures* mapExtentAsFeatures = new GeoprocessingFeatures(m_inputFeatures, this);
+    QUuid requestId = m_localGeospatialServer->executePipeline(pipelineName, GeospatialTaskContext::create(mapExtentAsFeatures, m_inputPolygon, m_inputVersion));
+    qDebug() << "Pipeline request" << requestId << "submitted.";
+}
+
+void GEOINTEngineer::selectTask(GeospatialTaskListModel *taskModel, int taskIndex)
+{
+    m_geospatialTaskListModel = taskModel;
+    m_selectedGeospatialTask = (0 <= taskIndex) ? m_geospatialTaskListModel->task(taskIndex) : nullptr;
+
+    // The speculation only serves the task it was started for
+    if (m_selectedGeospatialTask != m_speculativeExecution.geospatialTask)
+    {
+        discardSpeculativeExecution();
+    }
+}
+
+void GEOINTEngineer::supersedeInputs()
+{
+    m_inputVersion = m_localGeospatialServer->supersedeInputs();
+    discardSpeculativeExecution();
+}
+
+void GEOINTEngineer::startSpeculativeExecution()
+{
+    if (!m_speculativeExecutionEnabled
+            || !m_operationalLayerInitialized
+            || nullptr == m_selectedGeospatialTask
+            || !m_selectedGeospatialTask->hasInputFeaturesParameter())
+    {
+        return;
+    }
+
+    discardSpeculativeExecution();
+
+    // Runs in the background and reports to the speculation only
+    GeoprocessingFeatures* mapExtentAsFeatures = new GeoprocessingFeatures(m_inputFeatures, this);
+    GeospatialTaskContext taskContext = GeospatialTaskContext::create(mapExtentAsFeatures, m_inputPolygon, m_inputVersion);
+    taskContext.resultSink = [this](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+    {
+        if (requestId != m_speculativeExecution.requestId)
+        {
+            // Results of a discarded speculation are released
+            if (nullptr != mapImageLayerResult)
+            {
+                mapImageLayerResult->deleteLater();
+            }
+            if (nullptr != featureCollectionResult)
+            {
+                featureCollectionResult->deleteLater();
+            }
+            return;
+        }
+
+        if (m_speculativeExecution.adopted)
+        {
+            m_speculativeExecution = SpeculativeExecution();
+            if (nullptr == result && nullptr == mapImageLayerResult && nullptr == featureCollectionResult)
+            {
+                qDebug() << "Adopted speculative execution" << requestId << "failed!";
+                return;
+            }
+            onTaskCompleted(requestId, result, mapImageLayerResult, featureCollectionResult);
+            return;
+        }
+
+        qDebug() << "Speculative execution" << requestId << "completed.";
+        m_speculativeExecution.completed = true;
+        m_speculativeExecution.result = result;
+        m_speculativeExecution.mapImageLayerResult = mapImageLayerResult;
+        m_speculativeExecution.featureCollectionResult = featureCollectionResult;
+    };
+
+    m_speculativeExecution.requestId = taskContext.requestId;
+    m_speculativeExecution.geospatialTask = m_selectedGeospatialTask;
+    m_speculativeExecution.inputVersion = m_inputVersion;
+    qDebug() << "Speculative execution" << taskContext.requestId << "of" << m_selectedGeospatialTask->displayName() << "started.";
+    m_localGeospatialServer->speculateTask(m_selectedGeospatialTask, taskContext);
+}
+
+void GEOINTEngineer::discardSpeculativeExecution()
+{
+    if (m_speculativeExecution.requestId.isNull())
+    {
+        return;
+    }
+
+    qDebug() << "Speculative execution" << m_speculativeExecution.requestId << "discarded.";
+    QUuid requestId = m_speculativeExecution.requestId;
+    if (nullptr != m_speculativeExecution.mapImageLayerResult)
+    {
+        m_speculativeExecution.mapImageLayerResult->deleteLater();
+    }
+    if (nullptr != m_speculativeExecution.featureCollectionResult)
+    {
+        m_speculativeExecution.featureCollectionResult->deleteLater();
+    }
+    m_speculativeExecution = SpeculativeExecution();
+    m_localGeospatialServer->cancelTask(requestId);
+}
+
+bool GEOINTEngineer::adoptSpeculativeExecution(LocalGeospatialTask *geospatialTask)
+{
+    if (m_speculativeExecution.requestId.isNull()
+            || geospatialTask != m_speculativeExecution.geospatialTask
+            || m_inputVersion != m_speculativeExecution.inputVersion)
+    {
+        discardSpeculativeExecution();
+        return false;
+    }
+
+    // A failed speculation is executed again
+    SpeculativeExecution speculativeExecution = m_speculativeExecution;
+    if (speculativeExecution.completed)
+    {
+        m_speculativeExecution = SpeculativeExecution();
+        if (nullptr == speculativeExecution.result
+                && nullptr == speculativeExecution.mapImageLayerResult
+                && nullptr == speculativeExecution.featureCollectionResult)
+        {
+            return false;
+        }
+
+        qDebug() << "Adopting the result of speculative execution" << speculativeExecution.requestId;
+        onTaskCompleted(speculativeExecution.requestId, speculativeExecution.result, speculativeExecution.mapImageLayerResult, speculativeExecution.featureCollectionResult);
+        return true;
+    }
+
+    qDebug() << "Adopting speculative execution" << speculativeExecution.requestId << "in flight.";
+    m_speculativeExecution.adopted = true;
+    m_localGeospatialServer->prioritizeTask(speculativeExecution.requestId);
+    return true;
 }
 
 void GEOINTEngineer::addInputFeatures(Polygon &polygon)
@@ -341,6 +673,7 @@ void GEOINTEngineer::onInputFeatureAdded(QUuid, bool added)
     if (added)
     {
         qDebug() << "Input feature was added.";
+        startSpeculativeExecution();
         return;
     }
 
@@ -349,16 +682,61 @@ void GEOINTEngineer::onInputFeatureAdded(QUuid, bool added)
 
 void GEOINTEngineer::onMapLoaded(Map* map)
 {
+    if (nullptr == map || map == m_map)
+    {
+        return;
+    }
+
+    // The operational layers of a packaged map are known after it was loaded
+    if (LoadStatus::Loaded != map->loadStatus())
+    {
+        connect(map, &Map::doneLoading, this, [this, map](Error loadError)
+        {
+            if (!loadError.isEmpty())
+            {
+                qDebug() << "Loading the selected map failed!" << loadError.message();
+                return;
+            }
+
+            onMapLoaded(map);
+        }, Qt::SingleShotConnection);
+        map->load();
+        return;
+    }
+
     // Replace the current focus map
-    if (nullptr != m_mapView)
+    // the input, output and service layers are moved onto the new map
+    QList<Layer*> overlayLayers;
+    if (nullptr != m_map)
     {
-        m_mapView->setMap(map);
-        if (nullptr != m_map)
+        LayerListModel *operationalLayers = m_map->operationalLayers();
+        while (m_mapLayerCount < operationalLayers->size())
         {
-            delete m_map;
+            overlayLayers.append(operationalLayers->at(m_mapLayerCount));
+            operationalLayers->removeAt(m_mapLayerCount);
         }
-        m_map = map;
     }
+
+    m_mapLayerCount = map->operationalLayers()->size();
+    foreach (Layer *overlayLayer, overlayLayers)
+    {
+        map->operationalLayers()->append(overlayLayer);
+    }
+
+    if (nullptr != m_mapView)
+    {
+        m_mapView->setMap(map);
+    }
+
+    // Packaged maps are owned by the map package model
+    if (nullptr != m_map && this == m_map->parent())
+    {
+        delete m_map;
+    }
+    m_map = map;
+
+    // The package of the replaced map can be released now
+    m_mapPackageListModel->setCurrentMap(m_map);
 }
 
 void GEOINTEngineer::onMapServiceLoaded(ArcGISMapImageLayer *mapImageLayer)
@@ -369,15 +747,70 @@ void GEOINTEngineer::onMapServiceLoaded(ArcGISMapImageLayer *mapImageLayer)
     }
 }
 
+void GEOINTEngineer::onMapServiceRemoved(ArcGISMapImageLayer *mapImageLayer)
+{
+    if (nullptr != m_map)
+    {
+        m_map->operationalLayers()->removeOne(mapImageLayer);
+    }
+}
+
 void GEOINTEngineer::onTaskLoaded(LocalGeospatialTask *geospatialTask)
 {
     //m_geospatialTaskListModel->addTask(geospatialTask);
     emit taskLoaded(geospatialTask);
 }
 
-void GEOINTEngineer::onTaskCompleted(GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult)
+void GEOINTEngineer::onTaskRemoved(LocalGeospatialTask *geospatialTask)
+{
+    if (geospatialTask == m_currentGeospatialTask)
+    {
+        m_currentGeospatialTask = nullptr;
+    }
+    if (geospatialTask == m_selectedGeospatialTask)
+    {
+        m_selectedGeospatialTask = nullptr;
+    }
+    if (geospatialTask == m_speculativeExecution.geospatialTask)
+    {
+        discardSpeculativeExecution();
+    }
+
+    emit taskRemoved(geospatialTask);
+}
+
+void GEOINTEngineer::onSweepCompleted(QUuid requestId, GroupLayer *groupLayer)
+{
+    qDebug() << "Sweep request" << requestId << "completed.";
+    groupLayer->setParent(this);
+    m_map->operationalLayers()->append(groupLayer);
+}
+
+void GEOINTEngineer::onTimeWindowCompleted(QUuid requestId, GroupLayer *groupLayer, Layer *windowLayer)
+{
+    qDebug() << "Time window" << windowLayer->name() << "of request" << requestId << "completed.";
+    if (this != groupLayer->parent())
+    {
+        groupLayer->setParent(this);
+        m_map->operationalLayers()->append(groupLayer);
+    }
+
+    // The windows complete in any order but are listed chronologically
+    LayerListModel *windowLayers = groupLayer->layers();
+    int windowIndex = 0;
+    while (windowIndex < windowLayers->size()
+           && windowLayers->at(windowIndex)->name() < windowLayer->name())
+    {
+        windowIndex++;
+    }
+    windowLayer->setParent(groupLayer);
+    windowLayers->insert(windowIndex, windowLayer);
+}
+
+void GEOINTEngineer::onTaskCompleted(QUuid requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
 {
-    ArcGISMapImageLayer* resultMapImageLayer = result->mapImageLayer();
+    qDebug() << "Execution request" << requestId << "completed.";
+    ArcGISMapImageLayer* resultMapImageLayer = (nullptr != result) ? result->mapImageLayer() : nullptr;
     if (nullptr != resultMapImageLayer)
     {
         m_map->operationalLayers()->append(resultMapImageLayer);
@@ -389,6 +822,17 @@ void GEOINTEngineer::onTaskCompleted(GeoprocessingResult *result, ArcGISMapImage
         return;
     }
 
+    // Cached and tiled results carry their output features as a feature collection
+    if (nullptr != featureCollectionResult)
+    {
+        m_map->operationalLayers()->append(new FeatureCollectionLayer(featureCollectionResult, this));
+        return;
+    }
+    if (nullptr == result)
+    {
+        return;
+    }
+
     // Result is not drawn as a map image layer
     // We have to directly access the features
     // TODO: Specific renderer must be implemented!
@@ -461,6 +905,7 @@ void GEOINTEngineer::onPolygonConstructed(Polygon &polygon)
     }
 
     m_inputPolygon = polygon;
+    supersedeInputs();
 
     // First of all delete all input features
     // when delete all was executed, the current map extent
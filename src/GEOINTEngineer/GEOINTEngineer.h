@@ -14,9 +14,12 @@
 #ifndef GEOINTENGINEER_H
 #define GEOINTENGINEER_H
 
+class GeospatialJobScheduler;
 class GeospatialTaskListModel;
+class GeospatialTaskParameterModel;
 class LocalGeospatialServer;
 class LocalGeospatialTask;
+class MapPackageListModel;
 class MapViewTool;
 class PolygonSketchTool;
 
@@ -26,11 +29,14 @@ namespace ArcGISRuntime
 {
 class ArcGISMapImageLayer;
 class Feature;
+class FeatureCollection;
 class FeatureCollectionLayer;
 class FeatureCollectionTable;
 class FeatureQueryResult;
 class GeoprocessingFeatures;
 class GeoprocessingResult;
+class GroupLayer;
+class Layer;
 class Map;
 class MapQuickView;
 }
@@ -41,6 +47,7 @@ class MapQuickView;
 #include <QMap>
 #include <QMouseEvent>
 #include <QObject>
+#include <QStringList>
 #include <QUuid>
 
 class GEOINTEngineer : public QObject
@@ -48,6 +55,9 @@ class GEOINTEngineer : public QObject
     Q_OBJECT
 
     Q_PROPERTY(Esri::ArcGISRuntime::MapQuickView* mapView READ mapView WRITE setMapView NOTIFY mapViewChanged)
+    Q_PROPERTY(MapPackageListModel* mapPackages READ mapPackages CONSTANT)
+    Q_PROPERTY(GeospatialJobScheduler* jobScheduler READ jobScheduler CONSTANT)
+    Q_PROPERTY(QStringList pipelineNames READ pipelineNames CONSTANT)
 
 public:
     explicit GEOINTEngineer(QObject *parent = nullptr);
@@ -60,14 +70,19 @@ public:
     Q_INVOKABLE void deleteAllInputFeatures();
     Q_INVOKABLE void deleteAllOutputFeatures();
     Q_INVOKABLE void deleteAllFeatures();
-    Q_INVOKABLE void executeTask(GeospatialTaskListModel *taskModel, int taskIndex);
+    Q_INVOKABLE void executeTask(GeospatialTaskListModel *taskModel, int taskIndex, GeospatialTaskParameterModel *parameterModel = nullptr);
     Q_INVOKABLE void executeAllTasks(GeospatialTaskListModel *taskModel);
+    Q_INVOKABLE void selectTask(GeospatialTaskListModel *taskModel, int taskIndex);
+    Q_INVOKABLE void executePipeline(QString const &pipelineName);
+
+    Q_INVOKABLE void selectMapPackage(int packageIndex);
 
     Q_INVOKABLE void mousePositionChanged(qreal x, qreal y);
 
 signals:
     void mapViewChanged();
     void taskLoaded(LocalGeospatialTask *geospatialTask);
+    void taskRemoved(LocalGeospatialTask *geospatialTask);
 
 private slots:
     void onDeleteAllInputFeatures(QUuid, Esri::ArcGISRuntime::FeatureQueryResult *queryResult);
@@ -75,8 +90,12 @@ private slots:
     void onInputFeatureAdded(QUuid, bool);
     void onMapLoaded(Esri::ArcGISRuntime::Map *map);
     void onMapServiceLoaded(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
+    void onMapServiceRemoved(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
     void onTaskLoaded(LocalGeospatialTask *geospatialTask);
-    void onTaskCompleted(Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
+    void onTaskRemoved(LocalGeospatialTask *geospatialTask);
+    void onSweepCompleted(QUuid requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer);
+    void onTimeWindowCompleted(QUuid requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer, Esri::ArcGISRuntime::Layer *windowLayer);
+    void onTaskCompleted(QUuid requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
 
     void onMousePressed(QMouseEvent &mouseEvent);
     void onMouseMoved(QMouseEvent &mouseEvent);
@@ -90,14 +109,36 @@ private:
         AddInputFeature = 1
     };
 
+    // Execution of the selected task started before the user asked for it
+    struct SpeculativeExecution {
+        QUuid requestId;
+        LocalGeospatialTask *geospatialTask = nullptr;
+        quint64 inputVersion = 0;
+        bool adopted = false;
+        bool completed = false;
+        Esri::ArcGISRuntime::GeoprocessingResult *result = nullptr;
+        Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult = nullptr;
+        Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult = nullptr;
+    };
+
+    Esri::ArcGISRuntime::Map* createMap();
     void addInputFeatures(Esri::ArcGISRuntime::Polygon &polygon);
     void initOperationalLayers();
+    void supersedeInputs();
+    void startSpeculativeExecution();
+    void discardSpeculativeExecution();
+    bool adoptSpeculativeExecution(LocalGeospatialTask *geospatialTask);
     QList<Esri::ArcGISRuntime::Feature*> extractFeatures(Esri::ArcGISRuntime::FeatureQueryResult *queryResult);
 
+    MapPackageListModel* mapPackages() const;
+    GeospatialJobScheduler* jobScheduler() const;
+    QStringList pipelineNames() const;
+
     Esri::ArcGISRuntime::MapQuickView* mapView() const;
     void setMapView(Esri::ArcGISRuntime::MapQuickView *mapView);
 
     Esri::ArcGISRuntime::Map* m_map = nullptr;
+    int m_mapLayerCount = 0;
     Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
     Esri::ArcGISRuntime::FeatureCollectionLayer* m_inputFeatureLayer = nullptr;
     Esri::ArcGISRuntime::FeatureCollectionTable* m_inputFeatures = nullptr;
@@ -106,12 +147,17 @@ private:
     QMap<QUuid, QObject*> m_featuresLifetimes;
 
     LocalGeospatialServer* m_localGeospatialServer = nullptr;
+    MapPackageListModel* m_mapPackageListModel = nullptr;
     GeospatialTaskListModel* m_geospatialTaskListModel = nullptr;
     LocalGeospatialTask* m_currentGeospatialTask = nullptr;
+    LocalGeospatialTask* m_selectedGeospatialTask = nullptr;
+    bool m_speculativeExecutionEnabled = false;
+    SpeculativeExecution m_speculativeExecution;
 
     bool m_operationalLayerInitialized;
     DeletePostAction m_deletePostAction = DeletePostAction::None;
     Esri::ArcGISRuntime::Polygon m_inputPolygon;
+    quint64 m_inputVersion = 0;
 
     MapViewTool *m_currentTool = nullptr;
     PolygonSketchTool *m_polygonSketchTool = nullptr;
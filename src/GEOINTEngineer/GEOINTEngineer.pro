@@ -16,7 +16,7 @@ TEMPLATE = app
 CONFIG += c++17
 
 # additional modules are pulled in via arcgisruntime.pri
-QT += opengl qml quick quickcontrols2
+QT += concurrent opengl qml quick quickcontrols2 sql
 
 TARGET = GEOINTEngineer
 
@@ -38,20 +38,66 @@ include($$PWD/arcgisruntime.pri)
 
 HEADERS += \
     GEOINTEngineer.h \
+    GeospatialDatasetHandoff.h \
+    GeospatialInputUploads.h \
+    GeospatialJobScheduler.h \
+    GeospatialParameterSweep.h \
+    GeospatialPipelineDefinition.h \
+    GeospatialPipelineExecution.h \
+    GeospatialResultCache.h \
+    GeospatialSweepExecution.h \
+    GeospatialTaskCatalog.h \
+    GeospatialTaskContext.h \
+    GeospatialTaskInfo.h \
     GeospatialTaskListModel.h \
     GeospatialTaskParameter.h \
     GeospatialTaskParameterModel.h \
+    GeospatialTiledExecution.h \
+    GeospatialTimeSlicedExecution.h \
+    GeospatialTimeWindows.h \
+    LocalGeoprocessingPackage.h \
     LocalGeospatialServer.h \
     LocalGeospatialTask.h \
-    MapViewTool.h
+    LocalMapServiceGroup.h \
+    LocalServiceDaemon.h \
+    LocalServiceDaemonClient.h \
+    LocalServicePrewarmer.h \
+    LocalServiceScheduler.h \
+    LocalServiceWatchdog.h \
+    MapPackageListModel.h \
+    MapViewTool.h \
+    StartupTimeline.h
 
 SOURCES += \
+    GeospatialDatasetHandoff.cpp \
+    GeospatialInputUploads.cpp \
+    GeospatialJobScheduler.cpp \
+    GeospatialParameterSweep.cpp \
+    GeospatialPipelineDefinition.cpp \
+    GeospatialPipelineExecution.cpp \
+    GeospatialResultCache.cpp \
+    GeospatialSweepExecution.cpp \
+    GeospatialTaskCatalog.cpp \
+    GeospatialTaskContext.cpp \
+    GeospatialTaskInfo.cpp \
     GeospatialTaskListModel.cpp \
     GeospatialTaskParameter.cpp \
     GeospatialTaskParameterModel.cpp \
+    GeospatialTiledExecution.cpp \
+    GeospatialTimeSlicedExecution.cpp \
+    GeospatialTimeWindows.cpp \
+    LocalGeoprocessingPackage.cpp \
     LocalGeospatialServer.cpp \
     LocalGeospatialTask.cpp \
+    LocalMapServiceGroup.cpp \
+    LocalServiceDaemon.cpp \
+    LocalServiceDaemonClient.cpp \
+    LocalServicePrewarmer.cpp \
+    LocalServiceScheduler.cpp \
+    LocalServiceWatchdog.cpp \
+    MapPackageListModel.cpp \
     MapViewTool.cpp \
+    StartupTimeline.cpp \
     main.cpp \
     GEOINTEngineer.cpp
 
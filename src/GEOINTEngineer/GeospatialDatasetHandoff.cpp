@@ -0,0 +1,949 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialDatasetHandoff.h"
+#include "GeospatialInputUploads.h"
+
+#include "FeatureCollection.h"
+#include "GeoprocessingFeatures.h"
+#include "SpatialReference.h"
+
+#include <QDataStream>
+#include <QDate>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QJsonDocument>
+#include <QJsonValue>
+#include <QProcessEnvironment>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStringList>
+#include <QVariant>
+#include <QtConcurrent>
+
+#include <limits>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialDatasetHandoff::GeospatialDatasetHandoff(QObject *parent) :
+    QObject(parent),
+    m_scratchDirectoryPath(QDir::temp().filePath("geoint-engineer-scratch"))
+{
+    // File geodatabases cannot be written without ArcGIS, shapefiles are written instead
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString formatKeyName = "geoint.handoff.format";
+    if (systemEnvironment.contains(formatKeyName))
+    {
+        QString formatName = systemEnvironment.value(formatKeyName);
+        if (0 == formatName.compare("geopackage", Qt::CaseInsensitive))
+        {
+            m_format = Format::GeoPackage;
+        }
+        else if (0 != formatName.compare("shapefile", Qt::CaseInsensitive))
+        {
+            qDebug() << "Handoff format" << formatName << "is not supported, shapefiles are used instead.";
+        }
+    }
+
+    QString scratchKeyName = "geoint.handoff.scratch";
+    if (systemEnvironment.contains(scratchKeyName))
+    {
+        m_scratchDirectoryPath = systemEnvironment.value(scratchKeyName);
+    }
+}
+
+GeospatialDatasetHandoff::~GeospatialDatasetHandoff()
+{
+    foreach (Dataset const &dataset, m_datasets)
+    {
+        if (dataset.written)
+        {
+            removeDataset(dataset.filePath);
+        }
+    }
+}
+
+GeospatialDatasetHandoff::Format GeospatialDatasetHandoff::format() const
+{
+    return m_format;
+}
+
+QString GeospatialDatasetHandoff::scratchDirectoryPath() const
+{
+    return m_scratchDirectoryPath;
+}
+
+bool GeospatialDatasetHandoff::hasFinished(GeospatialTaskContext const &taskContext) const
+{
+    int datasetIndex = findDataset(taskContext);
+    return -1 != datasetIndex && m_datasets[datasetIndex].finished;
+}
+
+void GeospatialDatasetHandoff::acquireDataset(GeospatialTaskContext const &taskContext)
+{
+    // Every job of the same input version shares the dataset written for the first one
+    int datasetIndex = findDataset(taskContext);
+    if (-1 != datasetIndex)
+    {
+        m_datasets[datasetIndex].requestIds.insert(taskContext.requestId);
+        return;
+    }
+
+    Dataset newDataset;
+    newDataset.inputVersion = taskContext.inputVersion;
+    newDataset.writerRequestId = taskContext.requestId;
+    newDataset.requestIds.insert(taskContext.requestId);
+    if (nullptr == taskContext.inputFeatures
+            || nullptr == taskContext.inputFeatures->features())
+    {
+        newDataset.finished = true;
+        m_datasets.append(newDataset);
+        return;
+    }
+
+    QDir scratchDirectory(m_scratchDirectoryPath);
+    if (!scratchDirectory.mkpath("."))
+    {
+        qDebug() << "Scratch directory" << m_scratchDirectoryPath << "cannot be created!";
+        newDataset.finished = true;
+        m_datasets.append(newDataset);
+        return;
+    }
+
+    // Dataset names must not start with a digit
+    QString baseName = "input_" + QUuid::createUuid().toString(QUuid::Id128);
+    switch (m_format)
+    {
+    case Format::GeoPackage:
+        newDataset.filePath = scratchDirectory.filePath(baseName + ".gpkg");
+        newDataset.datasetPath = QDir::toNativeSeparators(newDataset.filePath + "/main.input_features");
+        break;
+
+    default:
+        newDataset.filePath = scratchDirectory.filePath(baseName + ".shp");
+        newDataset.datasetPath = QDir::toNativeSeparators(newDataset.filePath);
+        break;
+    }
+    m_datasets.append(newDataset);
+
+    // Writing a large dataset would block the GUI thread
+    // the worker only reads a copy of the input features
+    FeatureCollection *inputCollection = GeospatialInputUploads::copyFeatures(taskContext.inputFeatures);
+    Format format = m_format;
+    QString filePath = newDataset.filePath;
+    QFutureWatcher<bool> *writeWatcher = new QFutureWatcher<bool>(this);
+    connect(writeWatcher, &QFutureWatcher<bool>::finished, this, [this, writeWatcher, inputCollection, filePath]()
+    {
+        writeWatcher->deleteLater();
+        delete inputCollection;
+        datasetWritten(filePath, writeWatcher->result());
+    });
+    writeWatcher->setFuture(QtConcurrent::run([inputCollection, format, filePath]()
+    {
+        QJsonObject featureSetObject = QJsonDocument::fromJson(GeospatialInputUploads::featureSetJson(inputCollection)).object();
+        return writeDataset(format, filePath, featureSetObject);
+    }));
+    qDebug() << "Writing input version" << taskContext.inputVersion << "to" << newDataset.datasetPath << "...";
+}
+
+QString GeospatialDatasetHandoff::datasetPath(GeospatialTaskContext const &taskContext) const
+{
+    // A dataset that could not be written has no path
+    int datasetIndex = findDataset(taskContext);
+    if (-1 == datasetIndex
+            || !m_datasets[datasetIndex].written)
+    {
+        return QString();
+    }
+
+    return m_datasets[datasetIndex].datasetPath;
+}
+
+void GeospatialDatasetHandoff::releaseDataset(QUuid const &requestId)
+{
+    // The dataset is removed as soon as the last job reading it finished
+    for (int datasetIndex = 0; datasetIndex < m_datasets.size(); datasetIndex++)
+    {
+        Dataset &dataset = m_datasets[datasetIndex];
+        if (dataset.requestIds.remove(requestId)
+                && dataset.requestIds.isEmpty())
+        {
+            // A dataset still being written is removed once the worker is done
+            if (dataset.finished
+                    && dataset.written)
+            {
+                removeDataset(dataset.filePath);
+                qDebug() << "Dataset" << dataset.datasetPath << "removed.";
+            }
+            m_datasets.removeAt(datasetIndex);
+            return;
+        }
+    }
+}
+
+int GeospatialDatasetHandoff::findDataset(GeospatialTaskContext const &taskContext) const
+{
+    for (int datasetIndex = 0; datasetIndex < m_datasets.size(); datasetIndex++)
+    {
+        Dataset const &dataset = m_datasets[datasetIndex];
+        if (0 == taskContext.inputVersion)
+        {
+            if (0 == dataset.inputVersion
+                    && taskContext.requestId == dataset.writerRequestId)
+            {
+                return datasetIndex;
+            }
+        }
+        else if (taskContext.inputVersion == dataset.inputVersion)
+        {
+            return datasetIndex;
+        }
+    }
+
+    return -1;
+}
+
+void GeospatialDatasetHandoff::datasetWritten(QString const &filePath, bool written)
+{
+    int datasetIndex = -1;
+    for (int index = 0; index < m_datasets.size(); index++)
+    {
+        if (filePath == m_datasets[index].filePath)
+        {
+            datasetIndex = index;
+            break;
+        }
+    }
+
+    // The jobs reading the dataset finished in the meantime
+    if (-1 == datasetIndex
+            || !written)
+    {
+        removeDataset(filePath);
+    }
+    if (-1 == datasetIndex)
+    {
+        return;
+    }
+
+    Dataset &dataset = m_datasets[datasetIndex];
+    dataset.finished = true;
+    dataset.written = written;
+    if (written)
+    {
+        qDebug() << "Input version" << dataset.inputVersion << "written to" << dataset.datasetPath;
+    }
+    else
+    {
+        qDebug() << "Writing the input features to" << dataset.filePath << "failed!";
+    }
+
+    emit datasetFinished();
+}
+
+bool GeospatialDatasetHandoff::writeDataset(Format format, QString const &filePath, QJsonObject const &featureSetObject)
+{
+    switch (format)
+    {
+    case Format::GeoPackage:
+        return writeGeoPackage(filePath, featureSetObject);
+
+    default:
+        return writeShapefile(filePath, featureSetObject);
+    }
+}
+
+void GeospatialDatasetHandoff::removeDataset(QString const &filePath)
+{
+    // A shapefile consists of several files sharing the base name
+    QFileInfo datasetFileInfo(filePath);
+    QDir datasetDirectory = datasetFileInfo.absoluteDir();
+    foreach (QString const &suffix, QStringList() << "shp" << "shx" << "dbf" << "prj" << "cpg" << "gpkg" << "gpkg-journal")
+    {
+        QString datasetFilePath = datasetDirectory.filePath(datasetFileInfo.completeBaseName() + "." + suffix);
+        if (QFile::exists(datasetFilePath))
+        {
+            QFile::remove(datasetFilePath);
+        }
+    }
+}
+
+bool GeospatialDatasetHandoff::writeShapefile(QString const &filePath, QJsonObject const &featureSetObject)
+{
+    QString featureGeometryType = geometryType(featureSetObject);
+    qint32 shapeType = 0;
+    if ("esriGeometryPoint" == featureGeometryType)
+    {
+        shapeType = 1;
+    }
+    else if ("esriGeometryPolyline" == featureGeometryType)
+    {
+        shapeType = 3;
+    }
+    else if ("esriGeometryPolygon" == featureGeometryType)
+    {
+        shapeType = 5;
+    }
+    else
+    {
+        qDebug() << "Geometry type" << featureGeometryType << "cannot be written to a shapefile!";
+        return false;
+    }
+
+    // The shape records are little endian, the outer rings of polygons are clockwise like in Esri JSON
+    QJsonArray features = featureSetObject["features"].toArray();
+    QList<QByteArray> shapeRecords;
+    double xMin = std::numeric_limits<double>::max();
+    double yMin = std::numeric_limits<double>::max();
+    double xMax = std::numeric_limits<double>::lowest();
+    double yMax = std::numeric_limits<double>::lowest();
+    foreach (QJsonValue const &featureValue, features)
+    {
+        QByteArray shapeRecord;
+        QDataStream recordStream(&shapeRecord, QIODevice::WriteOnly);
+        recordStream.setByteOrder(QDataStream::LittleEndian);
+        QList<QJsonArray> parts = geometryParts(featureValue.toObject()["geometry"].toObject());
+        if (parts.isEmpty())
+        {
+            recordStream << qint32(0);
+            shapeRecords.append(shapeRecord);
+            continue;
+        }
+
+        double shapeXMin = std::numeric_limits<double>::max();
+        double shapeYMin = std::numeric_limits<double>::max();
+        double shapeXMax = std::numeric_limits<double>::lowest();
+        double shapeYMax = std::numeric_limits<double>::lowest();
+        qint32 pointCount = 0;
+        foreach (QJsonArray const &part, parts)
+        {
+            foreach (QJsonValue const &pointValue, part)
+            {
+                QJsonArray point = pointValue.toArray();
+                shapeXMin = qMin(shapeXMin, point[0].toDouble());
+                shapeYMin = qMin(shapeYMin, point[1].toDouble());
+                shapeXMax = qMax(shapeXMax, point[0].toDouble());
+                shapeYMax = qMax(shapeYMax, point[1].toDouble());
+                pointCount++;
+            }
+        }
+        xMin = qMin(xMin, shapeXMin);
+        yMin = qMin(yMin, shapeYMin);
+        xMax = qMax(xMax, shapeXMax);
+        yMax = qMax(yMax, shapeYMax);
+
+        recordStream << shapeType;
+        if (1 == shapeType)
+        {
+            recordStream << shapeXMin << shapeYMin;
+        }
+        else
+        {
+            recordStream << shapeXMin << shapeYMin << shapeXMax << shapeYMax << qint32(parts.size()) << pointCount;
+            qint32 partStart = 0;
+            foreach (QJsonArray const &part, parts)
+            {
+                recordStream << partStart;
+                partStart += part.size();
+            }
+            foreach (QJsonArray const &part, parts)
+            {
+                foreach (QJsonValue const &pointValue, part)
+                {
+                    QJsonArray point = pointValue.toArray();
+                    recordStream << point[0].toDouble() << point[1].toDouble();
+                }
+            }
+        }
+        shapeRecords.append(shapeRecord);
+    }
+    if (xMax < xMin)
+    {
+        xMin = yMin = xMax = yMax = 0;
+    }
+
+    // Main file and index share the header, lengths are counted in 16-bit words
+    auto writeHeader = [shapeType, xMin, yMin, xMax, yMax](QDataStream &stream, qint32 fileLength)
+    {
+        stream.setByteOrder(QDataStream::BigEndian);
+        stream << qint32(9994) << qint32(0) << qint32(0) << qint32(0) << qint32(0) << qint32(0) << fileLength;
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream << qint32(1000) << shapeType << xMin << yMin << xMax << yMax << 0.0 << 0.0 << 0.0 << 0.0;
+    };
+
+    QFileInfo shapeFileInfo(filePath);
+    QDir shapeDirectory = shapeFileInfo.absoluteDir();
+    QFile shapeFile(filePath);
+    QFile indexFile(shapeDirectory.filePath(shapeFileInfo.completeBaseName() + ".shx"));
+    if (!shapeFile.open(QIODevice::WriteOnly)
+            || !indexFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    qint32 shapeFileLength = 50;
+    foreach (QByteArray const &shapeRecord, shapeRecords)
+    {
+        shapeFileLength += 4 + shapeRecord.size() / 2;
+    }
+    QDataStream shapeStream(&shapeFile);
+    QDataStream indexStream(&indexFile);
+    writeHeader(shapeStream, shapeFileLength);
+    writeHeader(indexStream, 50 + 4 * shapeRecords.size());
+    qint32 recordOffset = 50;
+    for (int recordIndex = 0; recordIndex < shapeRecords.size(); recordIndex++)
+    {
+        QByteArray const &shapeRecord = shapeRecords[recordIndex];
+        qint32 contentLength = shapeRecord.size() / 2;
+        shapeStream.setByteOrder(QDataStream::BigEndian);
+        shapeStream << qint32(recordIndex + 1) << contentLength;
+        shapeStream.writeRawData(shapeRecord.constData(), shapeRecord.size());
+        indexStream.setByteOrder(QDataStream::BigEndian);
+        indexStream << recordOffset << contentLength;
+        recordOffset += 4 + contentLength;
+    }
+
+    // The attributes are stored as text of fixed length, the object identifiers are implied by the record order
+    struct DbfField {
+        QString name;
+        QByteArray dbfName;
+        char type;
+        int length;
+        int decimals;
+    };
+    QList<DbfField> dbfFields;
+    QSet<QByteArray> dbfNames;
+    foreach (QJsonValue const &fieldValue, featureSetObject["fields"].toArray())
+    {
+        QJsonObject fieldObject = fieldValue.toObject();
+        QString fieldType = fieldObject["type"].toString();
+        DbfField dbfField;
+        dbfField.name = fieldObject["name"].toString();
+        if ("esriFieldTypeSmallInteger" == fieldType
+                || "esriFieldTypeInteger" == fieldType)
+        {
+            dbfField.type = 'N';
+            dbfField.length = 11;
+            dbfField.decimals = 0;
+        }
+        else if ("esriFieldTypeSingle" == fieldType
+                 || "esriFieldTypeDouble" == fieldType)
+        {
+            dbfField.type = 'N';
+            dbfField.length = 19;
+            dbfField.decimals = 8;
+        }
+        else if ("esriFieldTypeDate" == fieldType)
+        {
+            dbfField.type = 'D';
+            dbfField.length = 8;
+            dbfField.decimals = 0;
+        }
+        else if ("esriFieldTypeString" == fieldType
+                 || "esriFieldTypeGUID" == fieldType
+                 || "esriFieldTypeGlobalID" == fieldType)
+        {
+            dbfField.type = 'C';
+            dbfField.length = qBound(1, fieldObject["length"].toInt(254), 254);
+            dbfField.decimals = 0;
+        }
+        else
+        {
+            continue;
+        }
+
+        // Field names are limited to ten characters, names colliding after the cut get a numbered suffix
+        dbfField.dbfName = dbfField.name.toLatin1().left(10);
+        for (int nameIndex = 1; dbfNames.contains(dbfField.dbfName.toUpper()); nameIndex++)
+        {
+            QByteArray nameSuffix = "_" + QByteArray::number(nameIndex);
+            dbfField.dbfName = dbfField.name.toLatin1().left(10 - nameSuffix.size()) + nameSuffix;
+        }
+        dbfNames.insert(dbfField.dbfName.toUpper());
+        dbfFields.append(dbfField);
+    }
+
+    // Numeric fields are widened to their largest value, wider values than a field can hold are rejected
+    auto numberText = [](QJsonValue const &attributeValue, int decimals)
+    {
+        double value = attributeValue.toDouble();
+        return qIsFinite(value) ? QByteArray::number(value, 'f', decimals) : QByteArray();
+    };
+    for (int fieldIndex = 0; fieldIndex < dbfFields.size(); fieldIndex++)
+    {
+        DbfField &dbfField = dbfFields[fieldIndex];
+        if ('N' != dbfField.type)
+        {
+            continue;
+        }
+
+        foreach (QJsonValue const &featureValue, features)
+        {
+            QJsonValue attributeValue = featureValue.toObject()["attributes"].toObject()[dbfField.name];
+            dbfField.length = qMax(dbfField.length, static_cast<int>(numberText(attributeValue, dbfField.decimals).size()));
+        }
+        if (254 < dbfField.length)
+        {
+            qDebug() << "Field" << dbfField.name << "holds values too wide for a shapefile!";
+            return false;
+        }
+    }
+
+    QFile attributeFile(shapeDirectory.filePath(shapeFileInfo.completeBaseName() + ".dbf"));
+    if (!attributeFile.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    int recordLength = 1;
+    foreach (DbfField const &dbfField, dbfFields)
+    {
+        recordLength += dbfField.length;
+    }
+    QDate today = QDate::currentDate();
+    QDataStream attributeStream(&attributeFile);
+    attributeStream.setByteOrder(QDataStream::LittleEndian);
+    attributeStream << quint8(3) << quint8(today.year() - 1900) << quint8(today.month()) << quint8(today.day())
+                    << quint32(features.size()) << quint16(32 + 32 * dbfFields.size() + 1) << quint16(recordLength);
+    attributeStream.writeRawData(QByteArray(20, '\0').constData(), 20);
+    foreach (DbfField const &dbfField, dbfFields)
+    {
+        QByteArray fieldDescriptor(32, '\0');
+        fieldDescriptor.replace(0, dbfField.dbfName.size(), dbfField.dbfName);
+        fieldDescriptor[11] = dbfField.type;
+        fieldDescriptor[16] = static_cast<char>(dbfField.length);
+        fieldDescriptor[17] = static_cast<char>(dbfField.decimals);
+        attributeStream.writeRawData(fieldDescriptor.constData(), fieldDescriptor.size());
+    }
+    attributeStream << quint8(0x0D);
+
+    foreach (QJsonValue const &featureValue, features)
+    {
+        QJsonObject attributesObject = featureValue.toObject()["attributes"].toObject();
+        QByteArray attributeRecord(" ");
+        foreach (DbfField const &dbfField, dbfFields)
+        {
+            QJsonValue attributeValue = attributesObject[dbfField.name];
+            QByteArray fieldText;
+            if (!attributeValue.isNull()
+                    && !attributeValue.isUndefined())
+            {
+                switch (dbfField.type)
+                {
+                case 'N':
+                    fieldText = numberText(attributeValue, dbfField.decimals).rightJustified(dbfField.length, ' ');
+                    break;
+
+                case 'D':
+                    fieldText = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(attributeValue.toDouble()), Qt::UTC).toString("yyyyMMdd").toLatin1();
+                    break;
+
+                default:
+                    {
+                        // A multibyte character cut by the field length is left out as a whole
+                        fieldText = attributeValue.toString().toUtf8();
+                        if (dbfField.length < fieldText.size())
+                        {
+                            int textLength = dbfField.length;
+                            while (0 < textLength
+                                    && 0x80 == (static_cast<uchar>(fieldText[textLength]) & 0xC0))
+                            {
+                                textLength--;
+                            }
+                            fieldText.truncate(textLength);
+                        }
+                    }
+                    break;
+                }
+            }
+            attributeRecord += fieldText.leftJustified(dbfField.length, ' ', true);
+        }
+        attributeStream.writeRawData(attributeRecord.constData(), attributeRecord.size());
+    }
+    attributeStream << quint8(0x1A);
+
+    // The attribute text is UTF-8 encoded, the coordinate system is optional
+    QFile codePageFile(shapeDirectory.filePath(shapeFileInfo.completeBaseName() + ".cpg"));
+    if (codePageFile.open(QIODevice::WriteOnly))
+    {
+        codePageFile.write("UTF-8");
+    }
+    QJsonObject spatialReferenceObject = featureSetObject["spatialReference"].toObject();
+    QString projectionText = spatialReferenceObject.contains("wkt") ? spatialReferenceObject["wkt"].toString() : SpatialReference(spatialReferenceObject["wkid"].toInt()).wkText();
+    QFile projectionFile(shapeDirectory.filePath(shapeFileInfo.completeBaseName() + ".prj"));
+    if (!projectionText.isEmpty()
+            && projectionFile.open(QIODevice::WriteOnly))
+    {
+        projectionFile.write(projectionText.toUtf8());
+    }
+
+    return QDataStream::Ok == shapeStream.status()
+            && QDataStream::Ok == indexStream.status()
+            && QDataStream::Ok == attributeStream.status();
+}
+
+bool GeospatialDatasetHandoff::writeGeoPackage(QString const &filePath, QJsonObject const &featureSetObject)
+{
+    QString featureGeometryType = geometryType(featureSetObject);
+    QString columnType;
+    if ("esriGeometryPoint" == featureGeometryType)
+    {
+        columnType = "POINT";
+    }
+    else if ("esriGeometryPolyline" == featureGeometryType)
+    {
+        columnType = "MULTILINESTRING";
+    }
+    else if ("esriGeometryPolygon" == featureGeometryType)
+    {
+        columnType = "MULTIPOLYGON";
+    }
+    else
+    {
+        qDebug() << "Geometry type" << featureGeometryType << "cannot be written to a GeoPackage!";
+        return false;
+    }
+
+    // Attribute columns by their field names, the object identifier becomes the feature identifier
+    QStringList columnNames;
+    QStringList columnDefinitions;
+    QStringList dateColumnNames;
+    foreach (QJsonValue const &fieldValue, featureSetObject["fields"].toArray())
+    {
+        QJsonObject fieldObject = fieldValue.toObject();
+        QString fieldType = fieldObject["type"].toString();
+        QString sqlType;
+        if ("esriFieldTypeSmallInteger" == fieldType
+                || "esriFieldTypeInteger" == fieldType)
+        {
+            sqlType = "INTEGER";
+        }
+        else if ("esriFieldTypeSingle" == fieldType
+                 || "esriFieldTypeDouble" == fieldType)
+        {
+            sqlType = "REAL";
+        }
+        else if ("esriFieldTypeDate" == fieldType)
+        {
+            sqlType = "DATETIME";
+            dateColumnNames.append(fieldObject["name"].toString());
+        }
+        else if ("esriFieldTypeString" == fieldType
+                 || "esriFieldTypeGUID" == fieldType
+                 || "esriFieldTypeGlobalID" == fieldType)
+        {
+            sqlType = "TEXT";
+        }
+        else
+        {
+            continue;
+        }
+
+        QString columnName = fieldObject["name"].toString();
+        columnNames.append(columnName);
+        columnDefinitions.append(QString("\"%1\" %2").arg(QString(columnName).replace("\"", "\"\""), sqlType));
+    }
+
+    QJsonObject spatialReferenceObject = featureSetObject["spatialReference"].toObject();
+    int srsId = spatialReferenceObject.contains("latestWkid") ? spatialReferenceObject["latestWkid"].toInt() : spatialReferenceObject["wkid"].toInt();
+    QString srsDefinition = spatialReferenceObject.contains("wkt") ? spatialReferenceObject["wkt"].toString() : SpatialReference(srsId).wkText();
+    if (0 == srsId)
+    {
+        srsId = -1;
+    }
+
+    // The connection must be released before it is removed
+    QString connectionName = "handoff-" + QUuid::createUuid().toString(QUuid::Id128);
+    bool written = false;
+    {
+        QSqlDatabase geoPackage = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        geoPackage.setDatabaseName(filePath);
+        if (geoPackage.open())
+        {
+            QSqlQuery query(geoPackage);
+            QStringList statements;
+            statements << "PRAGMA application_id = 1196444487"
+                       << "PRAGMA user_version = 10200"
+                       << "CREATE TABLE gpkg_spatial_ref_sys (srs_name TEXT NOT NULL, srs_id INTEGER PRIMARY KEY, organization TEXT NOT NULL, organization_coordsys_id INTEGER NOT NULL, definition TEXT NOT NULL, description TEXT)"
+                       << "CREATE TABLE gpkg_contents (table_name TEXT NOT NULL PRIMARY KEY, data_type TEXT NOT NULL, identifier TEXT UNIQUE, description TEXT DEFAULT '', last_change DATETIME NOT NULL DEFAULT (strftime('%Y-%m-%dT%H:%M:%fZ','now')), min_x DOUBLE, min_y DOUBLE, max_x DOUBLE, max_y DOUBLE, srs_id INTEGER, CONSTRAINT fk_gc_r_srs_id FOREIGN KEY (srs_id) REFERENCES gpkg_spatial_ref_sys(srs_id))"
+                       << "CREATE TABLE gpkg_geometry_columns (table_name TEXT NOT NULL, column_name TEXT NOT NULL, geometry_type_name TEXT NOT NULL, srs_id INTEGER NOT NULL, z TINYINT NOT NULL, m TINYINT NOT NULL, CONSTRAINT pk_geom_cols PRIMARY KEY (table_name, column_name), CONSTRAINT fk_gc_tn FOREIGN KEY (table_name) REFERENCES gpkg_contents(table_name), CONSTRAINT fk_gc_srs FOREIGN KEY (srs_id) REFERENCES gpkg_spatial_ref_sys (srs_id))"
+                       << "INSERT INTO gpkg_spatial_ref_sys VALUES ('Undefined cartesian SRS', -1, 'NONE', -1, 'undefined', NULL), ('Undefined geographic SRS', 0, 'NONE', 0, 'undefined', NULL), "
+                          "('WGS 84 geodetic', 4326, 'EPSG', 4326, 'GEOGCS[\"WGS 84\",DATUM[\"WGS_1984\",SPHEROID[\"WGS 84\",6378137,298.257223563,AUTHORITY[\"EPSG\",\"7030\"]],AUTHORITY[\"EPSG\",\"6326\"]],PRIMEM[\"Greenwich\",0,AUTHORITY[\"EPSG\",\"8901\"]],UNIT[\"degree\",0.0174532925199433,AUTHORITY[\"EPSG\",\"9122\"]],AUTHORITY[\"EPSG\",\"4326\"]]', 'longitude/latitude coordinates in decimal degrees on the WGS 84 spheroid')"
+                       << QString("CREATE TABLE input_features (fid INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, geom %1%2)").arg(columnType, columnDefinitions.isEmpty() ? QString() : ", " + columnDefinitions.join(", "));
+            written = geoPackage.transaction();
+            foreach (QString const &statement, statements)
+            {
+                written = written && query.exec(statement);
+            }
+
+            // Esri identifiers above the EPSG range belong to the Esri authority, WGS 84 is always defined
+            if (written
+                    && 0 < srsId
+                    && 4326 != srsId)
+            {
+                written = query.prepare("INSERT INTO gpkg_spatial_ref_sys VALUES (?, ?, ?, ?, ?, NULL)");
+                query.addBindValue(QString("WKID %1").arg(srsId));
+                query.addBindValue(srsId);
+                query.addBindValue(QString(srsId < 32768 ? "EPSG" : "ESRI"));
+                query.addBindValue(srsId);
+                query.addBindValue(srsDefinition.isEmpty() ? QString("undefined") : srsDefinition);
+                written = written && query.exec();
+            }
+
+            QString insertStatement = QString("INSERT INTO input_features (geom%1) VALUES (?%2)")
+                    .arg(columnNames.isEmpty() ? QString() : ", \"" + QStringList(columnNames).replaceInStrings("\"", "\"\"").join("\", \"") + "\"",
+                         QString(", ?").repeated(columnNames.size()));
+            written = written && query.prepare(insertStatement);
+            double xMin = std::numeric_limits<double>::max();
+            double yMin = std::numeric_limits<double>::max();
+            double xMax = std::numeric_limits<double>::lowest();
+            double yMax = std::numeric_limits<double>::lowest();
+            foreach (QJsonValue const &featureValue, featureSetObject["features"].toArray())
+            {
+                if (!written)
+                {
+                    break;
+                }
+
+                // Standard binary header with the envelope of the geometry, followed by its well known binary
+                QJsonObject featureObject = featureValue.toObject();
+                QJsonObject geometryObject = featureObject["geometry"].toObject();
+                QVariant geometryValue = QVariant(QMetaType::fromType<QByteArray>());
+                QList<QJsonArray> parts = geometryParts(geometryObject);
+                if (!parts.isEmpty())
+                {
+                    double shapeXMin = std::numeric_limits<double>::max();
+                    double shapeYMin = std::numeric_limits<double>::max();
+                    double shapeXMax = std::numeric_limits<double>::lowest();
+                    double shapeYMax = std::numeric_limits<double>::lowest();
+                    foreach (QJsonArray const &part, parts)
+                    {
+                        foreach (QJsonValue const &pointValue, part)
+                        {
+                            QJsonArray point = pointValue.toArray();
+                            shapeXMin = qMin(shapeXMin, point[0].toDouble());
+                            shapeYMin = qMin(shapeYMin, point[1].toDouble());
+                            shapeXMax = qMax(shapeXMax, point[0].toDouble());
+                            shapeYMax = qMax(shapeYMax, point[1].toDouble());
+                        }
+                    }
+                    xMin = qMin(xMin, shapeXMin);
+                    yMin = qMin(yMin, shapeYMin);
+                    xMax = qMax(xMax, shapeXMax);
+                    yMax = qMax(yMax, shapeYMax);
+
+                    QByteArray geometryBlob("GP");
+                    QDataStream blobStream(&geometryBlob, QIODevice::Append);
+                    blobStream.setByteOrder(QDataStream::LittleEndian);
+                    blobStream << quint8(0) << quint8(0x03) << qint32(srsId) << shapeXMin << shapeXMax << shapeYMin << shapeYMax;
+                    geometryBlob += wellKnownBinary(featureGeometryType, geometryObject);
+                    geometryValue = geometryBlob;
+                }
+                query.addBindValue(geometryValue);
+
+                QJsonObject attributesObject = featureObject["attributes"].toObject();
+                foreach (QString const &columnName, columnNames)
+                {
+                    QJsonValue attributeValue = attributesObject[columnName];
+                    if (dateColumnNames.contains(columnName)
+                            && attributeValue.isDouble())
+                    {
+                        query.addBindValue(QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(attributeValue.toDouble()), Qt::UTC).toString(Qt::ISODateWithMs));
+                    }
+                    else
+                    {
+                        query.addBindValue(attributeValue.toVariant());
+                    }
+                }
+                written = query.exec();
+            }
+            if (xMax < xMin)
+            {
+                xMin = yMin = xMax = yMax = 0;
+            }
+
+            if (written)
+            {
+                written = query.prepare("INSERT INTO gpkg_contents (table_name, data_type, identifier, min_x, min_y, max_x, max_y, srs_id) VALUES ('input_features', 'features', 'input_features', ?, ?, ?, ?, ?)");
+                query.addBindValue(xMin);
+                query.addBindValue(yMin);
+                query.addBindValue(xMax);
+                query.addBindValue(yMax);
+                query.addBindValue(srsId);
+                written = written && query.exec();
+            }
+            if (written)
+            {
+                written = query.prepare("INSERT INTO gpkg_geometry_columns VALUES ('input_features', 'geom', ?, ?, 0, 0)");
+                query.addBindValue(columnType);
+                query.addBindValue(srsId);
+                written = written && query.exec();
+            }
+
+            if (written)
+            {
+                written = geoPackage.commit();
+            }
+            else
+            {
+                qDebug() << "GeoPackage" << filePath << "failed:" << query.lastError().text();
+                geoPackage.rollback();
+            }
+            geoPackage.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return written;
+}
+
+QString GeospatialDatasetHandoff::geometryType(QJsonObject const &featureSetObject)
+{
+    if (featureSetObject.contains("geometryType"))
+    {
+        return featureSetObject["geometryType"].toString();
+    }
+
+    // The type is derived from the first geometry otherwise
+    QJsonArray features = featureSetObject["features"].toArray();
+    if (features.isEmpty())
+    {
+        return QString();
+    }
+
+    QJsonObject geometryObject = features.first().toObject()["geometry"].toObject();
+    if (geometryObject.contains("rings"))
+    {
+        return "esriGeometryPolygon";
+    }
+    if (geometryObject.contains("paths"))
+    {
+        return "esriGeometryPolyline";
+    }
+    if (geometryObject.contains("x"))
+    {
+        return "esriGeometryPoint";
+    }
+
+    return QString();
+}
+
+QList<QJsonArray> GeospatialDatasetHandoff::geometryParts(QJsonObject const &geometryObject)
+{
+    // A point is a single part of a single coordinate pair
+    QList<QJsonArray> parts;
+    if (geometryObject["x"].isDouble())
+    {
+        parts.append(QJsonArray { QJsonArray { geometryObject["x"], geometryObject["y"] } });
+        return parts;
+    }
+
+    QJsonArray partArrays = geometryObject.contains("rings") ? geometryObject["rings"].toArray() : geometryObject["paths"].toArray();
+    foreach (QJsonValue const &partValue, partArrays)
+    {
+        QJsonArray part = partValue.toArray();
+        if (!part.isEmpty())
+        {
+            parts.append(part);
+        }
+    }
+
+    return parts;
+}
+
+bool GeospatialDatasetHandoff::isClockwise(QJsonArray const &ring)
+{
+    double doubleArea = 0;
+    for (int pointIndex = 1; pointIndex < ring.size(); pointIndex++)
+    {
+        QJsonArray previousPoint = ring[pointIndex - 1].toArray();
+        QJsonArray point = ring[pointIndex].toArray();
+        doubleArea += (point[0].toDouble() - previousPoint[0].toDouble()) * (point[1].toDouble() + previousPoint[1].toDouble());
+    }
+
+    return 0 < doubleArea;
+}
+
+QByteArray GeospatialDatasetHandoff::wellKnownBinary(QString const &geometryType, QJsonObject const &geometryObject)
+{
+    QByteArray wkb;
+    QDataStream wkbStream(&wkb, QIODevice::WriteOnly);
+    wkbStream.setByteOrder(QDataStream::LittleEndian);
+    QList<QJsonArray> parts = geometryParts(geometryObject);
+    auto writePoints = [&wkbStream](QJsonArray const &part)
+    {
+        wkbStream << quint32(part.size());
+        foreach (QJsonValue const &pointValue, part)
+        {
+            QJsonArray point = pointValue.toArray();
+            wkbStream << point[0].toDouble() << point[1].toDouble();
+        }
+    };
+
+    if ("esriGeometryPoint" == geometryType)
+    {
+        QJsonArray point = parts.first().first().toArray();
+        wkbStream << quint8(1) << quint32(1) << point[0].toDouble() << point[1].toDouble();
+    }
+    else if ("esriGeometryPolyline" == geometryType)
+    {
+        wkbStream << quint8(1) << quint32(5) << quint32(parts.size());
+        foreach (QJsonArray const &path, parts)
+        {
+            wkbStream << quint8(1) << quint32(2);
+            writePoints(path);
+        }
+    }
+    else
+    {
+        // Clockwise rings start a polygon, the following counterclockwise rings are its holes
+        QList<QList<QJsonArray>> polygons;
+        foreach (QJsonArray const &ring, parts)
+        {
+            if (polygons.isEmpty()
+                    || isClockwise(ring))
+            {
+                polygons.append(QList<QJsonArray>());
+            }
+            polygons.last().append(ring);
+        }
+
+        wkbStream << quint8(1) << quint32(6) << quint32(polygons.size());
+        foreach (QList<QJsonArray> const &rings, polygons)
+        {
+            wkbStream << quint8(1) << quint32(3) << quint32(rings.size());
+            foreach (QJsonArray const &ring, rings)
+            {
+                writePoints(ring);
+            }
+        }
+    }
+
+    return wkb;
+}
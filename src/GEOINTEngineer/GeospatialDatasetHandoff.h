@@ -0,0 +1,93 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALDATASETHANDOFF_H
+#define GEOSPATIALDATASETHANDOFF_H
+
+#include "GeospatialTaskContext.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QUuid>
+
+// Input features written once into a dataset of the scratch directory, the jobs only receive its path
+class GeospatialDatasetHandoff : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Format {
+        Shapefile = 0,
+        GeoPackage = 1
+    };
+
+    explicit GeospatialDatasetHandoff(QObject *parent = nullptr);
+    ~GeospatialDatasetHandoff() override;
+
+    Format format() const;
+    QString scratchDirectoryPath() const;
+
+    bool hasFinished(GeospatialTaskContext const &taskContext) const;
+    void acquireDataset(GeospatialTaskContext const &taskContext);
+    QString datasetPath(GeospatialTaskContext const &taskContext) const;
+    void releaseDataset(QUuid const &requestId);
+
+signals:
+    void datasetFinished();
+
+private:
+    struct Dataset {
+        quint64 inputVersion = 0;
+        // Unversioned inputs are written for the requesting execution only
+        QUuid writerRequestId;
+        QString filePath;
+        QString datasetPath;
+        QSet<QUuid> requestIds;
+        bool finished = false;
+        bool written = false;
+    };
+
+    int findDataset(GeospatialTaskContext const &taskContext) const;
+    void datasetWritten(QString const &filePath, bool written);
+
+    static bool writeDataset(Format format, QString const &filePath, QJsonObject const &featureSetObject);
+    static void removeDataset(QString const &filePath);
+
+    static bool writeShapefile(QString const &filePath, QJsonObject const &featureSetObject);
+    static bool writeGeoPackage(QString const &filePath, QJsonObject const &featureSetObject);
+    static QString geometryType(QJsonObject const &featureSetObject);
+    static QList<QJsonArray> geometryParts(QJsonObject const &geometryObject);
+    static bool isClockwise(QJsonArray const &ring);
+    static QByteArray wellKnownBinary(QString const &geometryType, QJsonObject const &geometryObject);
+
+    Format m_format = Format::Shapefile;
+    QString m_scratchDirectoryPath;
+    QList<Dataset> m_datasets;
+};
+
+#endif // GEOSPATIALDATASETHANDOFF_H
@@ -0,0 +1,270 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialInputUploads.h"
+
+#include "FeatureCollection.h"
+#include "FeatureCollectionTable.h"
+#include "FeatureCollectionTableListModel.h"
+#include "FeatureSet.h"
+#include "GeoprocessingFeatures.h"
+
+#include <QDebug>
+#include <QFutureWatcher>
+#include <QHttpMultiPart>
+#include <QHttpPart>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QProcessEnvironment>
+#include <QUrlQuery>
+#include <QtConcurrent>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialInputUploads::GeospatialInputUploads(QObject *parent) :
+    QObject(parent),
+    m_networkAccessManager(new QNetworkAccessManager(this))
+{
+    // The input features are uploaded once instead of being sent by every job
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString uploadsKeyName = "geoint.jobs.uploads";
+    if (systemEnvironment.contains(uploadsKeyName))
+    {
+        m_enabled = (0 == systemEnvironment.value(uploadsKeyName).compare("true", Qt::CaseInsensitive));
+    }
+}
+
+bool GeospatialInputUploads::isUploadable(GeospatialTaskContext const &taskContext) const
+{
+    // Only versioned inputs are replaced by a newer version which releases their uploads
+    return m_enabled
+            && 0 != taskContext.inputVersion
+            && nullptr != taskContext.inputFeatures
+            && nullptr != taskContext.inputFeatures->features();
+}
+
+bool GeospatialInputUploads::hasFinished(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext) const
+{
+    int uploadIndex = findUpload(serviceUrl, taskContext.inputVersion);
+    return -1 != uploadIndex && m_uploads[uploadIndex].finished;
+}
+
+GeoprocessingFeatures* GeospatialInputUploads::uploadedFeatures(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext) const
+{
+    int uploadIndex = findUpload(serviceUrl, taskContext.inputVersion);
+    if (-1 == uploadIndex)
+    {
+        return nullptr;
+    }
+
+    return m_uploads[uploadIndex].uploadedFeatures;
+}
+
+void GeospatialInputUploads::upload(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext)
+{
+    if (-1 != findUpload(serviceUrl, taskContext.inputVersion))
+    {
+        return;
+    }
+
+    Upload newUpload;
+    newUpload.serviceUrl = serviceUrl;
+    newUpload.inputVersion = taskContext.inputVersion;
+    m_uploads.append(newUpload);
+
+    // Serializing a large feature set would block the GUI thread
+    // the worker only reads a copy of the input features
+    FeatureCollection *inputCollection = copyFeatures(taskContext.inputFeatures);
+    quint64 inputVersion = taskContext.inputVersion;
+    QFutureWatcher<QByteArray> *serializeWatcher = new QFutureWatcher<QByteArray>(this);
+    connect(serializeWatcher, &QFutureWatcher<QByteArray>::finished, this, [this, serializeWatcher, inputCollection, serviceUrl, inputVersion]()
+    {
+        serializeWatcher->deleteLater();
+        delete inputCollection;
+        if (-1 == findUpload(serviceUrl, inputVersion))
+        {
+            // The upload was released in the meantime
+            return;
+        }
+
+        postFeatureSet(serviceUrl, inputVersion, serializeWatcher->result());
+    });
+    serializeWatcher->setFuture(QtConcurrent::run([inputCollection]()
+    {
+        return featureSetJson(inputCollection);
+    }));
+}
+
+void GeospatialInputUploads::postFeatureSet(QUrl const &serviceUrl, quint64 inputVersion, QByteArray const &featureSetJson)
+{
+    // The feature set is posted as a JSON file to the uploads endpoint of the service
+    QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+    QHttpPart filePart;
+    filePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/json"));
+    filePart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"file\"; filename=\"inputfeatures.json\""));
+    filePart.setBody(featureSetJson);
+    multiPart->append(filePart);
+    QHttpPart formatPart;
+    formatPart.setHeader(QNetworkRequest::ContentDispositionHeader, QVariant("form-data; name=\"f\""));
+    formatPart.setBody("json");
+    multiPart->append(formatPart);
+
+    QNetworkRequest uploadRequest(QUrl(serviceUrl.toString() + "/uploads/upload"));
+    QNetworkReply *uploadReply = m_networkAccessManager->post(uploadRequest, multiPart);
+    multiPart->setParent(uploadReply);
+    connect(uploadReply, &QNetworkReply::finished, this, [this, uploadReply, serviceUrl, inputVersion]()
+    {
+        QByteArray response;
+        if (QNetworkReply::NoError == uploadReply->error())
+        {
+            response = uploadReply->readAll();
+        }
+        else
+        {
+            qDebug() << "Uploading the input features to" << serviceUrl << "failed:" << uploadReply->errorString();
+        }
+        uploadReply->deleteLater();
+        uploadCompleted(serviceUrl, inputVersion, response);
+    });
+    qDebug() << "Uploading input version" << inputVersion << "to" << serviceUrl << "...";
+}
+
+void GeospatialInputUploads::uploadCompleted(QUrl const &serviceUrl, quint64 inputVersion, QByteArray const &response)
+{
+    // The upload was released in the meantime
+    int uploadIndex = findUpload(serviceUrl, inputVersion);
+    QString itemId = QJsonDocument::fromJson(response).object()["item"].toObject()["itemID"].toString();
+    if (-1 == uploadIndex)
+    {
+        if (!itemId.isEmpty())
+        {
+            deleteItem(serviceUrl, itemId);
+        }
+        return;
+    }
+
+    // Every job of this input version reads the uploaded feature set by its URL
+    Upload &upload = m_uploads[uploadIndex];
+    upload.finished = true;
+    if (itemId.isEmpty())
+    {
+        qDebug() << "Input version" << inputVersion << "is sent inline to" << serviceUrl;
+    }
+    else
+    {
+        upload.itemId = itemId;
+        upload.uploadedFeatures = new GeoprocessingFeatures(QUrl(serviceUrl.toString() + "/uploads/" + itemId + "/download"), this);
+        qDebug() << "Input version" << inputVersion << "uploaded to" << serviceUrl << "as" << itemId;
+    }
+
+    emit uploadFinished(serviceUrl);
+}
+
+void GeospatialInputUploads::releaseUploads(quint64 currentInputVersion)
+{
+    for (int uploadIndex = m_uploads.size() - 1; 0 <= uploadIndex; uploadIndex--)
+    {
+        Upload const &upload = m_uploads[uploadIndex];
+        if (currentInputVersion <= upload.inputVersion)
+        {
+            continue;
+        }
+
+        // The uploaded item is deleted on the server as well
+        if (!upload.itemId.isEmpty())
+        {
+            deleteItem(upload.serviceUrl, upload.itemId);
+            qDebug() << "Upload" << upload.itemId << "of input version" << upload.inputVersion << "released.";
+        }
+        if (nullptr != upload.uploadedFeatures)
+        {
+            upload.uploadedFeatures->deleteLater();
+        }
+        m_uploads.removeAt(uploadIndex);
+    }
+}
+
+QUrl GeospatialInputUploads::serviceUrl(QUrl const &taskUrl)
+{
+    // The task endpoint is located beneath the service endpoint
+    QString taskEndpoint = taskUrl.toString();
+    return QUrl(taskEndpoint.left(taskEndpoint.lastIndexOf('/')));
+}
+
+int GeospatialInputUploads::findUpload(QUrl const &serviceUrl, quint64 inputVersion) const
+{
+    // Every input version is uploaded once per service whatever features object carries it
+    for (int uploadIndex = 0; uploadIndex < m_uploads.size(); uploadIndex++)
+    {
+        Upload const &upload = m_uploads[uploadIndex];
+        if (serviceUrl == upload.serviceUrl
+                && inputVersion == upload.inputVersion)
+        {
+            return uploadIndex;
+        }
+    }
+
+    return -1;
+}
+
+void GeospatialInputUploads::deleteItem(QUrl const &serviceUrl, QString const &itemId)
+{
+    QUrlQuery deleteQuery;
+    deleteQuery.addQueryItem("f", "json");
+    QNetworkRequest deleteRequest(QUrl(serviceUrl.toString() + "/uploads/" + itemId + "/delete"));
+    deleteRequest.setHeader(QNetworkRequest::ContentTypeHeader, QVariant("application/x-www-form-urlencoded"));
+    QNetworkReply *deleteReply = m_networkAccessManager->post(deleteRequest, deleteQuery.toString(QUrl::FullyEncoded).toUtf8());
+    connect(deleteReply, &QNetworkReply::finished, deleteReply, &QNetworkReply::deleteLater);
+}
+
+FeatureCollection* GeospatialInputUploads::copyFeatures(GeoprocessingFeatures *inputFeatures)
+{
+    // The only layer of the collection holds a copy of the input features
+    FeatureCollection *inputCollection = new FeatureCollection();
+    inputCollection->tables()->append(new FeatureCollectionTable(inputFeatures->features(), inputCollection));
+    return inputCollection;
+}
+
+QByteArray GeospatialInputUploads::featureSetJson(FeatureCollection *inputCollection)
+{
+    // The feature set of the only layer is the JSON a feature set parameter expects
+    QJsonObject collectionObject = QJsonDocument::fromJson(inputCollection->toJson().toUtf8()).object();
+    QJsonObject layerObject = collectionObject["layers"].toArray().first().toObject();
+    QJsonObject featureSetObject = layerObject["featureSet"].toObject();
+
+    // An empty feature set keeps the geometry type declared by its table
+    if (!featureSetObject.contains("geometryType"))
+    {
+        QJsonValue declaredGeometryType = layerObject["layerDefinition"].toObject()["geometryType"];
+        if (declaredGeometryType.isString())
+        {
+            featureSetObject.insert("geometryType", declaredGeometryType);
+        }
+    }
+    return QJsonDocument(featureSetObject).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,87 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALINPUTUPLOADS_H
+#define GEOSPATIALINPUTUPLOADS_H
+
+class QNetworkAccessManager;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class FeatureCollection;
+class GeoprocessingFeatures;
+}
+}
+
+#include "GeospatialTaskContext.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QUrl>
+
+// Input features uploaded once per input version to a geoprocessing service and referenced by all of its jobs
+class GeospatialInputUploads : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GeospatialInputUploads(QObject *parent = nullptr);
+
+    bool isUploadable(GeospatialTaskContext const &taskContext) const;
+    bool hasFinished(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext) const;
+    Esri::ArcGISRuntime::GeoprocessingFeatures* uploadedFeatures(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext) const;
+    void upload(QUrl const &serviceUrl, GeospatialTaskContext const &taskContext);
+    void releaseUploads(quint64 currentInputVersion);
+
+    static QUrl serviceUrl(QUrl const &taskUrl);
+    static Esri::ArcGISRuntime::FeatureCollection* copyFeatures(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures);
+    static QByteArray featureSetJson(Esri::ArcGISRuntime::FeatureCollection *inputCollection);
+
+signals:
+    void uploadFinished(QUrl const &serviceUrl);
+
+private:
+    struct Upload {
+        QUrl serviceUrl;
+        quint64 inputVersion = 0;
+        QString itemId;
+        // Without uploaded features the jobs send the input features themselves
+        Esri::ArcGISRuntime::GeoprocessingFeatures *uploadedFeatures = nullptr;
+        bool finished = false;
+    };
+
+    int findUpload(QUrl const &serviceUrl, quint64 inputVersion) const;
+    void deleteItem(QUrl const &serviceUrl, QString const &itemId);
+    void postFeatureSet(QUrl const &serviceUrl, quint64 inputVersion, QByteArray const &featureSetJson);
+    void uploadCompleted(QUrl const &serviceUrl, quint64 inputVersion, QByteArray const &response);
+
+    QNetworkAccessManager *m_networkAccessManager;
+    QList<Upload> m_uploads;
+    bool m_enabled = false;
+};
+
+#endif // GEOSPATIALINPUTUPLOADS_H
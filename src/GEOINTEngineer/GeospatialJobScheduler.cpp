@@ -0,0 +1,356 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialJobScheduler.h"
+#include "LocalGeospatialTask.h"
+
+#include <QDebug>
+#include <QProcessEnvironment>
+#include <QThread>
+#include <QTimer>
+
+GeospatialJobScheduler::GeospatialJobScheduler(QObject *parent) :
+    QObject(parent),
+    m_concurrencyLimit(qMax(1, QThread::idealThreadCount())),
+    m_priorityQueues(3)
+{
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString concurrencyKeyName = "geoint.jobs.concurrency";
+    if (systemEnvironment.contains(concurrencyKeyName))
+    {
+        bool validLimit = false;
+        int concurrencyLimit = systemEnvironment.value(concurrencyKeyName).toInt(&validLimit);
+        if (validLimit)
+        {
+            setConcurrencyLimit(concurrencyLimit);
+        }
+    }
+
+    QString serviceConcurrencyKeyName = "geoint.jobs.serviceconcurrency";
+    if (systemEnvironment.contains(serviceConcurrencyKeyName))
+    {
+        bool validLimit = false;
+        int serviceConcurrencyLimit = systemEnvironment.value(serviceConcurrencyKeyName).toInt(&validLimit);
+        if (validLimit)
+        {
+            setServiceConcurrencyLimit(serviceConcurrencyLimit);
+        }
+    }
+}
+
+int GeospatialJobScheduler::concurrencyLimit() const
+{
+    return m_concurrencyLimit;
+}
+
+void GeospatialJobScheduler::setConcurrencyLimit(int concurrencyLimit)
+{
+    m_concurrencyLimit = qMax(1, concurrencyLimit);
+    scheduleDispatch();
+}
+
+int GeospatialJobScheduler::serviceConcurrencyLimit() const
+{
+    return m_serviceConcurrencyLimit;
+}
+
+void GeospatialJobScheduler::setServiceConcurrencyLimit(int serviceConcurrencyLimit)
+{
+    m_serviceConcurrencyLimit = qMax(1, serviceConcurrencyLimit);
+    scheduleDispatch();
+}
+
+void GeospatialJobScheduler::submit(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, Priority priority)
+{
+    // Every geoprocessing package is served by its own pool of services
+    QString serviceKey = geospatialTask->packageFilePath();
+    PriorityQueue &priorityQueue = m_priorityQueues[static_cast<int>(priority)];
+    if (!priorityQueue.serviceOrder.contains(serviceKey))
+    {
+        priorityQueue.serviceOrder.append(serviceKey);
+    }
+
+    QueuedJob queuedJob;
+    queuedJob.geospatialTask = geospatialTask;
+    queuedJob.taskContext = taskContext;
+    queuedJob.queuedTimer.start();
+    priorityQueue.serviceJobs[serviceKey].append(queuedJob);
+
+    emit metricsChanged();
+    scheduleDispatch();
+}
+
+void GeospatialJobScheduler::finishJob(LocalGeospatialTask *geospatialTask)
+{
+    if (!m_runningJobs.contains(geospatialTask))
+    {
+        return;
+    }
+
+    if (0 == --m_runningJobs[geospatialTask])
+    {
+        m_runningJobs.remove(geospatialTask);
+    }
+
+    emit metricsChanged();
+    scheduleDispatch();
+}
+
+void GeospatialJobScheduler::removeTask(LocalGeospatialTask *geospatialTask)
+{
+    // Queued jobs are dropped and the running jobs release their slots
+    for (int priorityIndex = 0, priorityCount = m_priorityQueues.size(); priorityIndex < priorityCount; priorityIndex++)
+    {
+        PriorityQueue &priorityQueue = m_priorityQueues[priorityIndex];
+        QList<QueuedJob> &serviceJobs = priorityQueue.serviceJobs[geospatialTask->packageFilePath()];
+        for (int jobIndex = serviceJobs.size() - 1; 0 <= jobIndex; jobIndex--)
+        {
+            if (geospatialTask == serviceJobs[jobIndex].geospatialTask)
+            {
+                serviceJobs.removeAt(jobIndex);
+            }
+        }
+    }
+    m_runningJobs.remove(geospatialTask);
+
+    emit metricsChanged();
+    scheduleDispatch();
+}
+
+QList<GeospatialTaskContext> GeospatialJobScheduler::removeJobs(GeospatialTaskFilter const &taskFilter)
+{
+    // Removed jobs never start
+    QList<GeospatialTaskContext> removedContexts;
+    for (int priorityIndex = 0, priorityCount = m_priorityQueues.size(); priorityIndex < priorityCount; priorityIndex++)
+    {
+        PriorityQueue &priorityQueue = m_priorityQueues[priorityIndex];
+        for (auto serviceIterator = priorityQueue.serviceJobs.begin(); serviceIterator != priorityQueue.serviceJobs.end(); ++serviceIterator)
+        {
+            QList<QueuedJob> &serviceJobs = serviceIterator.value();
+            for (int jobIndex = serviceJobs.size() - 1; 0 <= jobIndex; jobIndex--)
+            {
+                if (taskFilter(serviceJobs[jobIndex].taskContext))
+                {
+                    removedContexts.prepend(serviceJobs.takeAt(jobIndex).taskContext);
+                }
+            }
+        }
+    }
+
+    if (!removedContexts.isEmpty())
+    {
+        qDebug() << removedContexts.size() << "queued jobs were removed.";
+        emit metricsChanged();
+    }
+    return removedContexts;
+}
+
+bool GeospatialJobScheduler::changePriority(QUuid const &requestId, Priority priority)
+{
+    // The queued job keeps its wait time and moves to the end of the other priority
+    for (int priorityIndex = 0, priorityCount = m_priorityQueues.size(); priorityIndex < priorityCount; priorityIndex++)
+    {
+        PriorityQueue &priorityQueue = m_priorityQueues[priorityIndex];
+        for (auto serviceIterator = priorityQueue.serviceJobs.begin(); serviceIterator != priorityQueue.serviceJobs.end(); ++serviceIterator)
+        {
+            QList<QueuedJob> &serviceJobs = serviceIterator.value();
+            for (int jobIndex = 0, jobCount = serviceJobs.size(); jobIndex < jobCount; jobIndex++)
+            {
+                if (requestId != serviceJobs[jobIndex].taskContext.requestId)
+                {
+                    continue;
+                }
+
+                if (static_cast<int>(priority) == priorityIndex)
+                {
+                    return true;
+                }
+
+                QString serviceKey = serviceIterator.key();
+                QueuedJob queuedJob = serviceJobs.takeAt(jobIndex);
+                PriorityQueue &targetQueue = m_priorityQueues[static_cast<int>(priority)];
+                if (!targetQueue.serviceOrder.contains(serviceKey))
+                {
+                    targetQueue.serviceOrder.append(serviceKey);
+                }
+                targetQueue.serviceJobs[serviceKey].append(queuedJob);
+
+                emit metricsChanged();
+                scheduleDispatch();
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int GeospatialJobScheduler::queueDepth() const
+{
+    int queueDepth = 0;
+    for (int priorityIndex = 0, priorityCount = m_priorityQueues.size(); priorityIndex < priorityCount; priorityIndex++)
+    {
+        queueDepth += this->queueDepth(static_cast<Priority>(priorityIndex));
+    }
+
+    return queueDepth;
+}
+
+int GeospatialJobScheduler::queueDepth(Priority priority) const
+{
+    int queueDepth = 0;
+    foreach (QList<QueuedJob> const &serviceJobs, m_priorityQueues[static_cast<int>(priority)].serviceJobs)
+    {
+        queueDepth += serviceJobs.size();
+    }
+
+    return queueDepth;
+}
+
+int GeospatialJobScheduler::queueDepth(QString const &serviceKey) const
+{
+    int queueDepth = 0;
+    foreach (PriorityQueue const &priorityQueue, m_priorityQueues)
+    {
+        queueDepth += priorityQueue.serviceJobs.value(serviceKey).size();
+    }
+
+    return queueDepth;
+}
+
+int GeospatialJobScheduler::runningJobCount() const
+{
+    int runningJobCount = 0;
+    foreach (int taskJobCount, m_runningJobs)
+    {
+        runningJobCount += taskJobCount;
+    }
+
+    return runningJobCount;
+}
+
+int GeospatialJobScheduler::runningJobCount(QString const &serviceKey) const
+{
+    int runningJobCount = 0;
+    for (auto jobIterator = m_runningJobs.constBegin(); jobIterator != m_runningJobs.constEnd(); ++jobIterator)
+    {
+        if (serviceKey == jobIterator.key()->packageFilePath())
+        {
+            runningJobCount += jobIterator.value();
+        }
+    }
+
+    return runningJobCount;
+}
+
+qint64 GeospatialJobScheduler::averageWaitTime() const
+{
+    if (0 == m_dispatchedJobCount)
+    {
+        return 0;
+    }
+
+    return m_totalWaitTime / m_dispatchedJobCount;
+}
+
+qint64 GeospatialJobScheduler::maximumWaitTime() const
+{
+    return m_maximumWaitTime;
+}
+
+void GeospatialJobScheduler::scheduleDispatch()
+{
+    // Collect the submissions of the current event loop iteration first
+    if (m_dispatchScheduled)
+    {
+        return;
+    }
+
+    m_dispatchScheduled = true;
+    QTimer::singleShot(0, this, &GeospatialJobScheduler::dispatch);
+}
+
+void GeospatialJobScheduler::dispatch()
+{
+    m_dispatchScheduled = false;
+
+    // Interactive jobs are always dispatched before batch and background jobs
+    bool dispatched = false;
+    while (runningJobCount() < m_concurrencyLimit)
+    {
+        bool dispatchedNext = false;
+        for (int priorityIndex = 0, priorityCount = m_priorityQueues.size(); priorityIndex < priorityCount && !dispatchedNext; priorityIndex++)
+        {
+            dispatchedNext = dispatchNext(m_priorityQueues[priorityIndex]);
+        }
+
+        if (!dispatchedNext)
+        {
+            break;
+        }
+        dispatched = true;
+    }
+
+    if (dispatched)
+    {
+        qDebug() << "Jobs running:" << runningJobCount() << "queued:" << queueDepth()
+                 << "average wait:" << averageWaitTime() << "ms maximum wait:" << maximumWaitTime() << "ms";
+        emit metricsChanged();
+    }
+}
+
+bool GeospatialJobScheduler::dispatchNext(PriorityQueue &priorityQueue)
+{
+    // Round robin across the services, the service served last moves to the end
+    for (int serviceIndex = 0, serviceCount = priorityQueue.serviceOrder.size(); serviceIndex < serviceCount; serviceIndex++)
+    {
+        QString serviceKey = priorityQueue.serviceOrder[serviceIndex];
+        QList<QueuedJob> &serviceJobs = priorityQueue.serviceJobs[serviceKey];
+        if (serviceJobs.isEmpty())
+        {
+            continue;
+        }
+
+        // Every service instance of the package takes its own share of jobs
+        int serviceInstanceCount = qMax(1, serviceJobs.first().geospatialTask->instanceCount());
+        if (m_serviceConcurrencyLimit * serviceInstanceCount <= runningJobCount(serviceKey))
+        {
+            continue;
+        }
+
+        QueuedJob queuedJob = serviceJobs.takeFirst();
+        priorityQueue.serviceOrder.move(serviceIndex, serviceCount - 1);
+
+        qint64 waitTime = queuedJob.queuedTimer.elapsed();
+        m_dispatchedJobCount++;
+        m_totalWaitTime += waitTime;
+        m_maximumWaitTime = qMax(m_maximumWaitTime, waitTime);
+        m_runningJobs[queuedJob.geospatialTask]++;
+
+        emit jobReady(queuedJob.geospatialTask, queuedJob.taskContext);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,107 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALJOBSCHEDULER_H
+#define GEOSPATIALJOBSCHEDULER_H
+
+class LocalGeospatialTask;
+
+#include "GeospatialTaskContext.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+
+class GeospatialJobScheduler : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int queueDepth READ queueDepth NOTIFY metricsChanged)
+    Q_PROPERTY(int runningJobCount READ runningJobCount NOTIFY metricsChanged)
+    Q_PROPERTY(qint64 averageWaitTime READ averageWaitTime NOTIFY metricsChanged)
+    Q_PROPERTY(qint64 maximumWaitTime READ maximumWaitTime NOTIFY metricsChanged)
+
+public:
+    enum class Priority {
+        Interactive = 0,
+        Batch = 1,
+        Background = 2
+    };
+    Q_ENUM(Priority)
+
+    explicit GeospatialJobScheduler(QObject *parent = nullptr);
+
+    int concurrencyLimit() const;
+    void setConcurrencyLimit(int concurrencyLimit);
+    int serviceConcurrencyLimit() const;
+    void setServiceConcurrencyLimit(int serviceConcurrencyLimit);
+
+    void submit(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, Priority priority);
+    void finishJob(LocalGeospatialTask *geospatialTask);
+    void removeTask(LocalGeospatialTask *geospatialTask);
+    QList<GeospatialTaskContext> removeJobs(GeospatialTaskFilter const &taskFilter);
+    bool changePriority(QUuid const &requestId, Priority priority);
+
+    int queueDepth() const;
+    int queueDepth(Priority priority) const;
+    int queueDepth(QString const &serviceKey) const;
+    int runningJobCount() const;
+    int runningJobCount(QString const &serviceKey) const;
+    qint64 averageWaitTime() const;
+    qint64 maximumWaitTime() const;
+
+signals:
+    void jobReady(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext);
+    void metricsChanged();
+
+private:
+    struct QueuedJob {
+        LocalGeospatialTask *geospatialTask = nullptr;
+        GeospatialTaskContext taskContext;
+        QElapsedTimer queuedTimer;
+    };
+
+    struct PriorityQueue {
+        QStringList serviceOrder;
+        QMap<QString, QList<QueuedJob>> serviceJobs;
+    };
+
+    void scheduleDispatch();
+    void dispatch();
+    bool dispatchNext(PriorityQueue &priorityQueue);
+
+    int m_concurrencyLimit;
+    int m_serviceConcurrencyLimit = 2;
+    bool m_dispatchScheduled = false;
+    QList<PriorityQueue> m_priorityQueues;
+    QMap<LocalGeospatialTask*, int> m_runningJobs;
+    qint64 m_dispatchedJobCount = 0;
+    qint64 m_totalWaitTime = 0;
+    qint64 m_maximumWaitTime = 0;
+};
+
+#endif // GEOSPATIALJOBSCHEDULER_H
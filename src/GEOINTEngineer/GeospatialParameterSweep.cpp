@@ -0,0 +1,143 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialParameterSweep.h"
+
+#include "GeoprocessingDouble.h"
+#include "GeoprocessingLinearUnit.h"
+#include "GeoprocessingLong.h"
+
+#include <QDebug>
+#include <QStringList>
+
+using namespace Esri::ArcGISRuntime;
+
+bool GeospatialParameterSweep::isSweep() const
+{
+    return 1 < values.size();
+}
+
+GeoprocessingParameter* GeospatialParameterSweep::createParameter(double value, QObject *parent) const
+{
+    switch (dataType)
+    {
+    case GeoprocessingParameterType::GeoprocessingLinearUnit:
+        {
+            // The unit abbreviations offered by the linear unit editor
+            GeoprocessingLinearUnits linearUnits = GeoprocessingLinearUnits::Meter;
+            if (0 == unit.compare("KM", Qt::CaseInsensitive))
+            {
+                linearUnits = GeoprocessingLinearUnits::Kilometer;
+            }
+            else if (0 == unit.compare("NM", Qt::CaseInsensitive))
+            {
+                linearUnits = GeoprocessingLinearUnits::NauticalMile;
+            }
+            return new GeoprocessingLinearUnit(value, linearUnits, parent);
+        }
+
+    case GeoprocessingParameterType::GeoprocessingLong:
+        return new GeoprocessingLong(qRound(value), parent);
+
+    default:
+        return new GeoprocessingDouble(value, parent);
+    }
+}
+
+QString GeospatialParameterSweep::valueLabel(double value) const
+{
+    QString label = QString("%1 = %2").arg(parameterName, QString::number(value));
+    if (!unit.isEmpty())
+    {
+        label += " " + unit;
+    }
+
+    return label;
+}
+
+QList<double> GeospatialParameterSweep::parseValues(QString const &valueText)
+{
+    QList<double> values;
+    QStringList rangeParts = valueText.split(':');
+    if (3 == rangeParts.size())
+    {
+        bool validStart = false;
+        bool validStop = false;
+        bool validStep = false;
+        double start = rangeParts[0].trimmed().toDouble(&validStart);
+        double stop = rangeParts[1].trimmed().toDouble(&validStop);
+        double step = rangeParts[2].trimmed().toDouble(&validStep);
+        if (!validStart || !validStop || !validStep
+                || step <= 0 || stop < start)
+        {
+            qDebug() << "Invalid range" << valueText;
+            return values;
+        }
+
+        // The stop value is part of the range unless the step misses it
+        for (int valueIndex = 0; valueIndex < MaximumValueCount; valueIndex++)
+        {
+            double value = start + valueIndex * step;
+            if (stop + step * 1e-9 < value)
+            {
+                break;
+            }
+            values.append(value);
+        }
+        return values;
+    }
+
+    foreach (QString const &valuePart, valueText.split(',', Qt::SkipEmptyParts))
+    {
+        bool validValue = false;
+        double value = valuePart.trimmed().toDouble(&validValue);
+        if (!validValue)
+        {
+            qDebug() << "Invalid value" << valuePart;
+            return QList<double>();
+        }
+
+        if (!values.contains(value)
+                && values.size() < MaximumValueCount)
+        {
+            values.append(value);
+        }
+    }
+
+    return values;
+}
+
+bool GeospatialParameterSweep::isSweepable(GeoprocessingParameterType dataType)
+{
+    switch (dataType)
+    {
+    case GeoprocessingParameterType::GeoprocessingDouble:
+    case GeoprocessingParameterType::GeoprocessingLinearUnit:
+    case GeoprocessingParameterType::GeoprocessingLong:
+        return true;
+
+    default:
+        return false;
+    }
+}
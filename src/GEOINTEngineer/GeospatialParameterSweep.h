@@ -0,0 +1,62 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALPARAMETERSWEEP_H
+#define GEOSPATIALPARAMETERSWEEP_H
+
+class QObject;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class GeoprocessingParameter;
+}
+}
+
+#include "GeoprocessingTypes.h"
+
+#include <QList>
+#include <QString>
+
+// Values of a numeric or linear unit parameter, a single value or a list or range of values to sweep
+struct GeospatialParameterSweep
+{
+    QString parameterName;
+    Esri::ArcGISRuntime::GeoprocessingParameterType dataType = Esri::ArcGISRuntime::GeoprocessingParameterType::GeoprocessingDouble;
+    QList<double> values;
+    QString unit;
+
+    bool isSweep() const;
+    Esri::ArcGISRuntime::GeoprocessingParameter* createParameter(double value, QObject *parent) const;
+    QString valueLabel(double value) const;
+
+    // "250", "100, 250, 500" or the range "100:1000:100"
+    static QList<double> parseValues(QString const &valueText);
+    static bool isSweepable(Esri::ArcGISRuntime::GeoprocessingParameterType dataType);
+
+    const static int MaximumValueCount = 100;
+};
+
+#endif // GEOSPATIALPARAMETERSWEEP_H
@@ -0,0 +1,138 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialPipelineDefinition.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+QStringList GeospatialPipelineStep::dependencies() const
+{
+    QStringList stepIds;
+    foreach (QJsonValue const &inputValue, inputs)
+    {
+        QString stepId = inputValue.toObject()["step"].toString();
+        if (isReference(inputValue)
+                && !stepIds.contains(stepId))
+        {
+            stepIds.append(stepId);
+        }
+    }
+
+    return stepIds;
+}
+
+bool GeospatialPipelineStep::isReference(QJsonValue const &inputValue)
+{
+    // {"step": "buffer", "output": "Output_Features"}
+    QJsonObject referenceObject = inputValue.toObject();
+    return referenceObject.contains("step") && referenceObject.contains("output");
+}
+
+GeospatialPipelineStep GeospatialPipelineStep::fromJson(QJsonObject const &stepObject)
+{
+    GeospatialPipelineStep step;
+    step.id = stepObject["id"].toString();
+    step.taskName = stepObject["task"].toString();
+    if (step.id.isEmpty())
+    {
+        step.id = step.taskName;
+    }
+
+    QJsonObject inputsObject = stepObject["inputs"].toObject();
+    foreach (QString const &parameterName, inputsObject.keys())
+    {
+        step.inputs.insert(parameterName, inputsObject[parameterName]);
+    }
+
+    return step;
+}
+
+QStringList GeospatialPipelineDefinition::finalStepIds() const
+{
+    // Outputs nobody refers to are the products of the pipeline
+    QStringList referencedStepIds;
+    foreach (GeospatialPipelineStep const &step, steps)
+    {
+        referencedStepIds.append(step.dependencies());
+    }
+
+    QStringList stepIds;
+    foreach (GeospatialPipelineStep const &step, steps)
+    {
+        if (!referencedStepIds.contains(step.id))
+        {
+            stepIds.append(step.id);
+        }
+    }
+
+    return stepIds;
+}
+
+GeospatialPipelineDefinition GeospatialPipelineDefinition::fromJson(QJsonObject const &pipelineObject)
+{
+    GeospatialPipelineDefinition pipelineDefinition;
+    pipelineDefinition.name = pipelineObject["name"].toString();
+    foreach (QJsonValue const &stepValue, pipelineObject["steps"].toArray())
+    {
+        pipelineDefinition.steps.append(GeospatialPipelineStep::fromJson(stepValue.toObject()));
+    }
+
+    return pipelineDefinition;
+}
+
+QList<GeospatialPipelineDefinition> GeospatialPipelineDefinition::load(QString const &filePath)
+{
+    QList<GeospatialPipelineDefinition> pipelineDefinitions;
+    QFile pipelinesFile(filePath);
+    if (!pipelinesFile.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Cannot read the pipelines" << filePath;
+        return pipelineDefinitions;
+    }
+
+    QJsonDocument pipelinesDocument = QJsonDocument::fromJson(pipelinesFile.readAll());
+    if (!pipelinesDocument.isObject())
+    {
+        qDebug() << "Pipelines" << filePath << "are invalid!";
+        return pipelineDefinitions;
+    }
+
+    foreach (QJsonValue const &pipelineValue, pipelinesDocument.object()["pipelines"].toArray())
+    {
+        GeospatialPipelineDefinition pipelineDefinition = fromJson(pipelineValue.toObject());
+        if (pipelineDefinition.name.isEmpty()
+                || pipelineDefinition.steps.isEmpty())
+        {
+            qDebug() << "Pipeline without name or steps ignored!";
+            continue;
+        }
+
+        pipelineDefinitions.append(pipelineDefinition);
+    }
+
+    return pipelineDefinitions;
+}
@@ -0,0 +1,298 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialPipelineExecution.h"
+#include "GeospatialParameterSweep.h"
+#include "GeospatialTimeWindows.h"
+#include "LocalGeospatialTask.h"
+
+#include "ArcGISMapImageLayer.h"
+#include "FeatureCollection.h"
+#include "GeoprocessingBoolean.h"
+#include "GeoprocessingDate.h"
+#include "GeoprocessingDouble.h"
+#include "GeoprocessingFeatures.h"
+#include "GeoprocessingLinearUnit.h"
+#include "GeoprocessingLong.h"
+#include "GeoprocessingResult.h"
+#include "GeoprocessingString.h"
+
+#include <QDebug>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialPipelineExecution::GeospatialPipelineExecution(GeospatialPipelineDefinition const &pipelineDefinition, QMap<QString, LocalGeospatialTask*> const &stepTasks, GeospatialTaskContext const &pipelineContext, QObject *parent) :
+    QObject(parent),
+    m_pipelineDefinition(pipelineDefinition),
+    m_stepTasks(stepTasks),
+    m_pipelineContext(pipelineContext),
+    m_finalStepIds(pipelineDefinition.finalStepIds())
+{
+    // The job of an intermediate step is referenced by its URL
+    foreach (LocalGeospatialTask *geospatialTask, QSet<LocalGeospatialTask*>(m_stepTasks.cbegin(), m_stepTasks.cend()))
+    {
+        connect(geospatialTask, &LocalGeospatialTask::jobSucceeded, this, &GeospatialPipelineExecution::jobSucceeded);
+    }
+}
+
+void GeospatialPipelineExecution::start()
+{
+    foreach (GeospatialPipelineStep const &step, m_pipelineDefinition.steps)
+    {
+        m_stepStatus.insert(step.id, StepStatus::Waiting);
+    }
+
+    qDebug() << "Pipeline" << m_pipelineDefinition.name << "of execution request" << m_pipelineContext.requestId << "started.";
+    startReadySteps();
+}
+
+void GeospatialPipelineExecution::startReadySteps()
+{
+    // Steps whose inputs are available run in parallel, steps depending on a failed step are skipped
+    bool statusChanged = true;
+    while (statusChanged)
+    {
+        statusChanged = false;
+        foreach (GeospatialPipelineStep const &step, m_pipelineDefinition.steps)
+        {
+            if (StepStatus::Waiting != m_stepStatus.value(step.id))
+            {
+                continue;
+            }
+
+            bool inputsAvailable = true;
+            bool inputsFailed = false;
+            foreach (QString const &dependency, step.dependencies())
+            {
+                StepStatus dependencyStatus = m_stepStatus.value(dependency, StepStatus::Failed);
+                inputsAvailable = inputsAvailable && (StepStatus::Succeeded == dependencyStatus);
+                inputsFailed = inputsFailed || (StepStatus::Failed == dependencyStatus);
+            }
+
+            if (inputsFailed)
+            {
+                qDebug() << "Pipeline step" << step.id << "skipped, its inputs are missing!";
+                m_stepStatus[step.id] = StepStatus::Failed;
+                statusChanged = true;
+            }
+            else if (inputsAvailable)
+            {
+                m_stepStatus[step.id] = startStep(step) ? StepStatus::Running : StepStatus::Failed;
+                statusChanged = true;
+            }
+        }
+    }
+
+    // Steps still waiting without any running step refer to each other
+    QList<StepStatus> stepStatus = m_stepStatus.values();
+    if (stepStatus.contains(StepStatus::Running))
+    {
+        return;
+    }
+    if (stepStatus.contains(StepStatus::Waiting))
+    {
+        qDebug() << "Pipeline" << m_pipelineDefinition.name << "contains a cycle!";
+    }
+
+    if (!m_finished)
+    {
+        m_finished = true;
+        qDebug() << "Pipeline" << m_pipelineDefinition.name << "of execution request" << m_pipelineContext.requestId << "finished.";
+        emit executionCompleted(m_pipelineContext.requestId);
+    }
+}
+
+bool GeospatialPipelineExecution::startStep(GeospatialPipelineStep const &step)
+{
+    LocalGeospatialTask *geospatialTask = m_stepTasks.value(step.id);
+    if (nullptr == geospatialTask)
+    {
+        qDebug() << "Pipeline step" << step.id << "has no task" << step.taskName;
+        return false;
+    }
+
+    // The first input features of every step are the input features of the pipeline unless they are bound otherwise
+    GeospatialTaskContext stepContext = m_pipelineContext;
+    stepContext.requestId = QUuid::createUuid();
+    stepContext.resultByReference = !m_finalStepIds.contains(step.id);
+    for (auto inputIterator = step.inputs.constBegin(); inputIterator != step.inputs.constEnd(); ++inputIterator)
+    {
+        GeoprocessingParameter *inputParameter = createParameter(geospatialTask, inputIterator.key(), inputIterator.value());
+        if (nullptr == inputParameter)
+        {
+            qDebug() << "Input" << inputIterator.key() << "of pipeline step" << step.id << "is invalid!";
+            return false;
+        }
+
+        stepContext.parameterOverrides.insert(inputIterator.key(), inputParameter);
+    }
+
+    QPointer<GeospatialPipelineExecution> pipelineExecution(this);
+    stepContext.resultSink = [pipelineExecution](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+    {
+        if (!pipelineExecution.isNull())
+        {
+            pipelineExecution->completeStep(requestId, result, mapImageLayerResult, featureCollectionResult);
+        }
+    };
+
+    qDebug() << "Pipeline step" << step.id << "runs as execution request" << stepContext.requestId;
+    m_stepRequests.insert(stepContext.requestId, step.id);
+    emit stepReady(geospatialTask, stepContext);
+    return true;
+}
+
+GeoprocessingParameter* GeospatialPipelineExecution::createParameter(LocalGeospatialTask *geospatialTask, QString const &parameterName, QJsonValue const &inputValue)
+{
+    // Intermediate results stay on the server, the next step reads them from the job
+    if (GeospatialPipelineStep::isReference(inputValue))
+    {
+        QJsonObject referenceObject = inputValue.toObject();
+        QUrl jobUrl = m_jobUrls.value(referenceObject["step"].toString());
+        if (jobUrl.isEmpty())
+        {
+            return nullptr;
+        }
+
+        QUrl resultUrl(jobUrl.toString() + "/results/" + referenceObject["output"].toString());
+        return new GeoprocessingFeatures(resultUrl, this);
+    }
+
+    GeoprocessingParameterType dataType = GeoprocessingParameterType::GeoprocessingUnknownParameter;
+    foreach (GeospatialParameterInfo const &parameterInfo, geospatialTask->parameters())
+    {
+        if (parameterName == parameterInfo.name)
+        {
+            dataType = parameterInfo.dataType;
+            break;
+        }
+    }
+
+    // Literal values are converted to the declared type of the input
+    switch (dataType)
+    {
+    case GeoprocessingParameterType::GeoprocessingBoolean:
+        if (!inputValue.isBool())
+        {
+            return nullptr;
+        }
+        return new GeoprocessingBoolean(inputValue.toBool(), this);
+
+    case GeoprocessingParameterType::GeoprocessingLong:
+        if (!inputValue.isDouble())
+        {
+            return nullptr;
+        }
+        return new GeoprocessingLong(qRound(inputValue.toDouble()), this);
+
+    case GeoprocessingParameterType::GeoprocessingDouble:
+        if (!inputValue.isDouble())
+        {
+            return nullptr;
+        }
+        return new GeoprocessingDouble(inputValue.toDouble(), this);
+
+    case GeoprocessingParameterType::GeoprocessingLinearUnit:
+        {
+            // 500 in meters or "500 KM" using the unit abbreviations of the linear unit editor
+            GeospatialParameterSweep linearUnitValue;
+            linearUnitValue.parameterName = parameterName;
+            linearUnitValue.dataType = dataType;
+            if (inputValue.isDouble())
+            {
+                return linearUnitValue.createParameter(inputValue.toDouble(), this);
+            }
+
+            QStringList valueParts = inputValue.toString().split(' ', Qt::SkipEmptyParts);
+            bool validDistance = false;
+            double distance = valueParts.isEmpty() ? 0 : valueParts[0].toDouble(&validDistance);
+            if (!validDistance || 2 < valueParts.size())
+            {
+                return nullptr;
+            }
+
+            linearUnitValue.unit = valueParts.value(1);
+            return linearUnitValue.createParameter(distance, this);
+        }
+
+    case GeoprocessingParameterType::GeoprocessingDate:
+        {
+            // A single date such as "2024-01-01", ranges are only split by the task panel
+            GeospatialTimeWindows dateValue = GeospatialTimeWindows::parse(inputValue.toString());
+            if (!dateValue.start.isValid() || dateValue.isRange())
+            {
+                return nullptr;
+            }
+            return new GeoprocessingDate(dateValue.start, this);
+        }
+
+    case GeoprocessingParameterType::GeoprocessingString:
+        if (!inputValue.isString())
+        {
+            return nullptr;
+        }
+        return new GeoprocessingString(inputValue.toString(), this);
+
+    default:
+        qDebug() << "Input" << parameterName << "of task" << geospatialTask->name() << "has no literal data type!";
+        return nullptr;
+    }
+}
+
+void GeospatialPipelineExecution::jobSucceeded(QUuid const &stepRequestId, QUrl const &jobUrl)
+{
+    if (m_stepRequests.contains(stepRequestId))
+    {
+        m_jobUrls.insert(m_stepRequests.value(stepRequestId), jobUrl);
+    }
+}
+
+void GeospatialPipelineExecution::completeStep(QUuid const &stepRequestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+{
+    if (!m_stepRequests.contains(stepRequestId))
+    {
+        return;
+    }
+
+    // Only the final outputs are materialized in the client
+    QString stepId = m_stepRequests.take(stepRequestId);
+    bool finalStep = m_finalStepIds.contains(stepId);
+    bool succeeded = (nullptr != result || nullptr != mapImageLayerResult || nullptr != featureCollectionResult)
+            && (finalStep || m_jobUrls.contains(stepId));
+    m_stepStatus[stepId] = succeeded ? StepStatus::Succeeded : StepStatus::Failed;
+    if (!succeeded)
+    {
+        qDebug() << "Pipeline step" << stepId << "failed!";
+    }
+    else if (finalStep)
+    {
+        emit outputCompleted(stepRequestId, result, mapImageLayerResult, featureCollectionResult);
+    }
+
+    startReadySteps();
+}
@@ -0,0 +1,86 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALPIPELINEEXECUTION_H
+#define GEOSPATIALPIPELINEEXECUTION_H
+
+class LocalGeospatialTask;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class ArcGISMapImageLayer;
+class FeatureCollection;
+class GeoprocessingParameter;
+class GeoprocessingResult;
+}
+}
+
+#include "GeospatialPipelineDefinition.h"
+#include "GeospatialTaskContext.h"
+
+#include <QMap>
+#include <QObject>
+#include <QUrl>
+#include <QUuid>
+
+class GeospatialPipelineExecution : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GeospatialPipelineExecution(GeospatialPipelineDefinition const &pipelineDefinition, QMap<QString, LocalGeospatialTask*> const &stepTasks, GeospatialTaskContext const &pipelineContext, QObject *parent = nullptr);
+
+    void start();
+
+signals:
+    void stepReady(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &stepContext);
+    void outputCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    void executionCompleted(QUuid const &requestId);
+
+private:
+    enum class StepStatus {
+        Waiting = 0,
+        Running = 1,
+        Succeeded = 2,
+        Failed = 3
+    };
+
+    void startReadySteps();
+    bool startStep(GeospatialPipelineStep const &step);
+    void jobSucceeded(QUuid const &stepRequestId, QUrl const &jobUrl);
+    void completeStep(QUuid const &stepRequestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    Esri::ArcGISRuntime::GeoprocessingParameter* createParameter(LocalGeospatialTask *geospatialTask, QString const &parameterName, QJsonValue const &inputValue);
+
+    GeospatialPipelineDefinition m_pipelineDefinition;
+    QMap<QString, LocalGeospatialTask*> m_stepTasks;
+    GeospatialTaskContext m_pipelineContext;
+    QStringList m_finalStepIds;
+    QMap<QString, StepStatus> m_stepStatus;
+    QMap<QUuid, QString> m_stepRequests;
+    QMap<QString, QUrl> m_jobUrls;
+    bool m_finished = false;
+};
+
+#endif // GEOSPATIALPIPELINEEXECUTION_H
@@ -0,0 +1,254 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialResultCache.h"
+#include "GeospatialTaskContext.h"
+#include "LocalGeospatialTask.h"
+
+#include "FeatureCollection.h"
+#include "FeatureCollectionTable.h"
+#include "FeatureCollectionTableListModel.h"
+#include "GeometryEngine.h"
+#include "GeoprocessingBoolean.h"
+#include "GeoprocessingDate.h"
+#include "GeoprocessingDouble.h"
+#include "GeoprocessingFeatures.h"
+#include "GeoprocessingLinearUnit.h"
+#include "GeoprocessingLong.h"
+#include "GeoprocessingParameter.h"
+#include "GeoprocessingResult.h"
+#include "GeoprocessingString.h"
+#include "GeoprocessingTypes.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcessEnvironment>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialResultCache::GeospatialResultCache()
+{
+    // Size budget of the cached results in megabytes, zero disables the cache
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString cacheSizeKeyName = "geoint.results.cachesize";
+    if (systemEnvironment.contains(cacheSizeKeyName))
+    {
+        m_maximumSize = qMax(0LL, systemEnvironment.value(cacheSizeKeyName).toLongLong()) * 1024 * 1024;
+    }
+}
+
+bool GeospatialResultCache::isEnabled() const
+{
+    return 0 < m_maximumSize;
+}
+
+QString GeospatialResultCache::cacheDirectoryPath() const
+{
+    return QDir::temp().filePath("geoint-engineer-results");
+}
+
+QString GeospatialResultCache::resultFilePath(QByteArray const &resultKey) const
+{
+    return QDir(cacheDirectoryPath()).filePath(QString::fromLatin1(resultKey.toHex()) + ".json");
+}
+
+QByteArray GeospatialResultCache::key(LocalGeospatialTask const *geospatialTask, QByteArray const &packageContentHash, GeospatialTaskContext const &taskContext) const
+{
+    // Without the input geometry or the package content the result cannot be identified
+    if (taskContext.inputGeometry.isEmpty()
+            || packageContentHash.isEmpty())
+    {
+        return QByteArray();
+    }
+
+    QCryptographicHash resultHash(QCryptographicHash::Sha256);
+    resultHash.addData(geospatialTask->name().toUtf8());
+    resultHash.addData(packageContentHash);
+
+    // The simplified geometry has a well defined ring orientation
+    Geometry canonicalGeometry = GeometryEngine::simplify(taskContext.inputGeometry);
+    resultHash.addData(canonicalGeometry.toJson().toUtf8());
+
+    // The defaults are part of the package, only the overridden values differ
+    for (auto overrideIterator = taskContext.parameterOverrides.constBegin(); overrideIterator != taskContext.parameterOverrides.constEnd(); ++overrideIterator)
+    {
+        GeoprocessingParameter const *parameter = overrideIterator.value();
+        QString parameterValue;
+        switch (parameter->parameterType())
+        {
+        case GeoprocessingParameterType::GeoprocessingBoolean:
+            parameterValue = static_cast<GeoprocessingBoolean const*>(parameter)->value() ? "true" : "false";
+            break;
+
+        case GeoprocessingParameterType::GeoprocessingDate:
+            parameterValue = static_cast<GeoprocessingDate const*>(parameter)->value().toUTC().toString(Qt::ISODateWithMs);
+            break;
+
+        case GeoprocessingParameterType::GeoprocessingDouble:
+            parameterValue = QString::number(static_cast<GeoprocessingDouble const*>(parameter)->value(), 'g', 17);
+            break;
+
+        case GeoprocessingParameterType::GeoprocessingLinearUnit:
+            {
+                GeoprocessingLinearUnit const *linearUnit = static_cast<GeoprocessingLinearUnit const*>(parameter);
+                parameterValue = QString("%1 %2").arg(QString::number(linearUnit->value(), 'g', 17)).arg(static_cast<int>(linearUnit->units()));
+            }
+            break;
+
+        case GeoprocessingParameterType::GeoprocessingLong:
+            parameterValue = QString::number(static_cast<GeoprocessingLong const*>(parameter)->value());
+            break;
+
+        case GeoprocessingParameterType::GeoprocessingString:
+            parameterValue = static_cast<GeoprocessingString const*>(parameter)->value();
+            break;
+
+        default:
+            // Feature and raster values are not hashed
+            return QByteArray();
+        }
+
+        resultHash.addData(overrideIterator.key().toUtf8());
+        resultHash.addData(parameterValue.toUtf8());
+    }
+
+    return resultHash.result();
+}
+
+bool GeospatialResultCache::lookup(QByteArray const &resultKey, CachedResult &cachedResult) const
+{
+    QFile resultFile(resultFilePath(resultKey));
+    if (!resultFile.open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+
+    QJsonDocument resultDocument = QJsonDocument::fromJson(resultFile.readAll());
+    if (!resultDocument.isObject())
+    {
+        qDebug() << "Cached result" << resultFile.fileName() << "is invalid!";
+        resultFile.remove();
+        return false;
+    }
+
+    // The modification time orders the results for eviction
+    resultFile.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    resultFile.close();
+
+    QJsonObject resultObject = resultDocument.object();
+    cachedResult.mapImageLayerUrl = QUrl(resultObject["mapImageLayerUrl"].toString());
+    cachedResult.featureCollectionJson = resultObject["features"].toString();
+    return true;
+}
+
+void GeospatialResultCache::store(QByteArray const &resultKey, CachedResult const &cachedResult)
+{
+    if (!QDir().mkpath(cacheDirectoryPath()))
+    {
+        qDebug() << "Cannot create the result cache directory!";
+        return;
+    }
+
+    QJsonObject resultObject;
+    resultObject.insert("mapImageLayerUrl", cachedResult.mapImageLayerUrl.toString());
+    resultObject.insert("features", cachedResult.featureCollectionJson);
+
+    QFile resultFile(resultFilePath(resultKey));
+    if (!resultFile.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot save cached result" << resultFile.fileName() << "!";
+        return;
+    }
+
+    resultFile.write(QJsonDocument(resultObject).toJson(QJsonDocument::Compact));
+    resultFile.close();
+    evict();
+}
+
+void GeospatialResultCache::evict()
+{
+    // The least recently used results are removed first
+    QDir cacheDirectory(cacheDirectoryPath());
+    QFileInfoList resultFiles = cacheDirectory.entryInfoList(QStringList() << "*.json", QDir::Files, QDir::Time);
+    qint64 cacheSize = 0;
+    foreach (QFileInfo const &resultFileInfo, resultFiles)
+    {
+        cacheSize += resultFileInfo.size();
+    }
+
+    while (m_maximumSize < cacheSize
+           && !resultFiles.isEmpty())
+    {
+        QFileInfo oldestResultFileInfo = resultFiles.takeLast();
+        cacheSize -= oldestResultFileInfo.size();
+        QFile::remove(oldestResultFileInfo.absoluteFilePath());
+        qDebug() << "Cached result" << oldestResultFileInfo.fileName() << "evicted.";
+    }
+}
+
+FeatureCollection* GeospatialResultCache::copyFeatures(GeoprocessingResult *result)
+{
+    // All output features are kept as one feature collection
+    FeatureCollection *outputFeatureCollection = new FeatureCollection();
+    int outputTableCount = 0;
+    foreach (GeoprocessingParameter *outputParameter, result->outputs().values())
+    {
+        if (GeoprocessingParameterType::GeoprocessingFeatures == outputParameter->parameterType())
+        {
+            GeoprocessingFeatures *outputFeatures = static_cast<GeoprocessingFeatures*>(outputParameter);
+            if (nullptr != outputFeatures->features())
+            {
+                outputFeatureCollection->tables()->append(new FeatureCollectionTable(outputFeatures->features(), outputFeatureCollection));
+                outputTableCount++;
+            }
+        }
+    }
+
+    if (0 == outputTableCount)
+    {
+        delete outputFeatureCollection;
+        return nullptr;
+    }
+
+    return outputFeatureCollection;
+}
+
+QString GeospatialResultCache::featureCollectionJson(GeoprocessingResult *result)
+{
+    FeatureCollection *outputFeatureCollection = copyFeatures(result);
+    if (nullptr == outputFeatureCollection)
+    {
+        return QString();
+    }
+
+    QString outputJson = outputFeatureCollection->toJson();
+    delete outputFeatureCollection;
+    return outputJson;
+}
@@ -0,0 +1,72 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALRESULTCACHE_H
+#define GEOSPATIALRESULTCACHE_H
+
+class LocalGeospatialTask;
+struct GeospatialTaskContext;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class FeatureCollection;
+class GeoprocessingResult;
+}
+}
+
+#include <QByteArray>
+#include <QString>
+#include <QUrl>
+
+class GeospatialResultCache
+{
+public:
+    GeospatialResultCache();
+
+    struct CachedResult {
+        QUrl mapImageLayerUrl;
+        QString featureCollectionJson;
+    };
+
+    bool isEnabled() const;
+
+    QByteArray key(LocalGeospatialTask const *geospatialTask, QByteArray const &packageContentHash, GeospatialTaskContext const &taskContext) const;
+    bool lookup(QByteArray const &resultKey, CachedResult &cachedResult) const;
+    void store(QByteArray const &resultKey, CachedResult const &cachedResult);
+
+    static Esri::ArcGISRuntime::FeatureCollection* copyFeatures(Esri::ArcGISRuntime::GeoprocessingResult *result);
+    static QString featureCollectionJson(Esri::ArcGISRuntime::GeoprocessingResult *result);
+
+private:
+    QString cacheDirectoryPath() const;
+    QString resultFilePath(QByteArray const &resultKey) const;
+    void evict();
+
+    qint64 m_maximumSize = 256 * 1024 * 1024;
+};
+
+#endif // GEOSPATIALRESULTCACHE_H
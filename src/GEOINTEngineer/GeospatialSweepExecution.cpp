@@ -0,0 +1,149 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialResultCache.h"
+#include "GeospatialSweepExecution.h"
+#include "LocalGeospatialTask.h"
+
+#include "ArcGISMapImageLayer.h"
+#include "FeatureCollection.h"
+#include "FeatureCollectionLayer.h"
+#include "GeoprocessingParameter.h"
+#include "GeoprocessingResult.h"
+#include "GroupLayer.h"
+#include "Layer.h"
+
+#include <QDebug>
+#include <QPointer>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialSweepExecution::GeospatialSweepExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialParameterSweep const &parameterSweep, QObject *parent) :
+    QObject(parent),
+    m_geospatialTask(geospatialTask),
+    m_taskContext(taskContext),
+    m_parameterSweep(parameterSweep)
+{
+}
+
+void GeospatialSweepExecution::start()
+{
+    // Every variant shares the input features and differs by the swept value only
+    QList<GeospatialTaskContext> variantContexts;
+    QPointer<GeospatialSweepExecution> sweepExecution(this);
+    foreach (double value, m_parameterSweep.values)
+    {
+        GeospatialTaskContext variantContext = m_taskContext;
+        variantContext.requestId = QUuid::createUuid();
+        variantContext.parameterOverrides.insert(m_parameterSweep.parameterName, m_parameterSweep.createParameter(value, this));
+        variantContext.resultSink = [sweepExecution](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+        {
+            if (!sweepExecution.isNull())
+            {
+                sweepExecution->completeVariant(requestId, result, mapImageLayerResult, featureCollectionResult);
+            }
+        };
+        m_variants.insert(variantContext.requestId, value);
+        variantContexts.append(variantContext);
+    }
+
+    qDebug() << "Execution request" << m_taskContext.requestId << "of" << m_geospatialTask->name() << "sweeps" << m_parameterSweep.parameterName << "over" << m_parameterSweep.values.size() << "values.";
+    foreach (GeospatialTaskContext const &variantContext, variantContexts)
+    {
+        emit variantReady(m_geospatialTask, variantContext);
+    }
+}
+
+void GeospatialSweepExecution::completeVariant(QUuid const &variantRequestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+{
+    if (!m_variants.contains(variantRequestId))
+    {
+        return;
+    }
+
+    // The output of every variant becomes a layer named by its value
+    double value = m_variants.take(variantRequestId);
+    Layer *variantLayer = createResultLayer(result, mapImageLayerResult, featureCollectionResult, this);
+    if (nullptr == variantLayer)
+    {
+        qDebug() << "Variant" << m_parameterSweep.valueLabel(value) << "of execution request" << m_taskContext.requestId << "failed!";
+    }
+    else
+    {
+        variantLayer->setName(m_parameterSweep.valueLabel(value));
+        m_variantLayers.insert(value, variantLayer);
+    }
+
+    if (m_variants.isEmpty())
+    {
+        finish();
+    }
+}
+
+Layer* GeospatialSweepExecution::createResultLayer(GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult, QObject *parent)
+{
+    if (nullptr != result && nullptr != result->mapImageLayer())
+    {
+        return result->mapImageLayer();
+    }
+    if (nullptr != mapImageLayerResult)
+    {
+        return mapImageLayerResult;
+    }
+    if (nullptr != featureCollectionResult)
+    {
+        return new FeatureCollectionLayer(featureCollectionResult, parent);
+    }
+    if (nullptr == result)
+    {
+        return nullptr;
+    }
+
+    // Output features are copied into a feature collection of their own
+    FeatureCollection *resultFeatures = FeatureCollection::fromJson(GeospatialResultCache::featureCollectionJson(result), parent);
+    FeatureCollectionLayer *resultLayer = new FeatureCollectionLayer(resultFeatures, parent);
+    resultFeatures->setParent(resultLayer);
+    return resultLayer;
+}
+
+void GeospatialSweepExecution::finish()
+{
+    // The variants are grouped in the order of their values
+    GroupLayer *groupLayer = nullptr;
+    if (!m_variantLayers.isEmpty())
+    {
+        groupLayer = new GroupLayer(m_variantLayers.values(), this);
+        groupLayer->setName(QString("%1 (%2)").arg(m_geospatialTask->displayName(), m_parameterSweep.parameterName));
+        foreach (Layer *variantLayer, m_variantLayers)
+        {
+            if (this == variantLayer->parent())
+            {
+                variantLayer->setParent(groupLayer);
+            }
+        }
+    }
+
+    qDebug() << "Sweep of execution request" << m_taskContext.requestId << "collected" << m_variantLayers.size() << "variants.";
+    emit executionCompleted(m_taskContext.requestId, groupLayer);
+}
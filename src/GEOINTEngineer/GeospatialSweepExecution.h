@@ -0,0 +1,74 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALSWEEPEXECUTION_H
+#define GEOSPATIALSWEEPEXECUTION_H
+
+class LocalGeospatialTask;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class ArcGISMapImageLayer;
+class FeatureCollection;
+class GeoprocessingResult;
+class GroupLayer;
+class Layer;
+}
+}
+
+#include "GeospatialParameterSweep.h"
+#include "GeospatialTaskContext.h"
+
+#include <QMap>
+#include <QObject>
+#include <QUuid>
+
+class GeospatialSweepExecution : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GeospatialSweepExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialParameterSweep const &parameterSweep, QObject *parent = nullptr);
+
+    void start();
+
+    static Esri::ArcGISRuntime::Layer* createResultLayer(Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult, QObject *parent);
+
+signals:
+    void variantReady(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &variantContext);
+    void executionCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer);
+
+private:
+    void completeVariant(QUuid const &variantRequestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    void finish();
+
+    LocalGeospatialTask *m_geospatialTask;
+    GeospatialTaskContext m_taskContext;
+    GeospatialParameterSweep m_parameterSweep;
+    QMap<QUuid, double> m_variants;
+    QMap<double, Esri::ArcGISRuntime::Layer*> m_variantLayers;
+};
+
+#endif // GEOSPATIALSWEEPEXECUTION_H
@@ -0,0 +1,221 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialTaskCatalog.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+GeospatialTaskCatalog::GeospatialTaskCatalog()
+{
+}
+
+QString GeospatialTaskCatalog::catalogFilePath() const
+{
+    return QDir::temp().filePath("geoint-engineer-task-catalog.json");
+}
+
+void GeospatialTaskCatalog::load()
+{
+    m_entries.clear();
+    QFile catalogFile(catalogFilePath());
+    if (!catalogFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonDocument catalogDocument = QJsonDocument::fromJson(catalogFile.readAll());
+    if (!catalogDocument.isObject())
+    {
+        qDebug() << "Task catalog is invalid!";
+        return;
+    }
+
+    QJsonObject catalogObject = catalogDocument.object();
+    foreach (QString const &packageFilePath, catalogObject.keys())
+    {
+        QJsonObject entryObject = catalogObject[packageFilePath].toObject();
+        CatalogEntry catalogEntry;
+        catalogEntry.size = entryObject["size"].toVariant().toLongLong();
+        catalogEntry.lastModified = QDateTime::fromString(entryObject["lastModified"].toString(), Qt::ISODateWithMs);
+        catalogEntry.contentHash = QByteArray::fromHex(entryObject["contentHash"].toString().toLatin1());
+        foreach (QJsonValue const &taskValue, entryObject["tasks"].toArray())
+        {
+            catalogEntry.taskInfos.append(GeospatialTaskInfo::fromJson(taskValue.toObject()));
+        }
+        m_entries.insert(packageFilePath, catalogEntry);
+    }
+}
+
+void GeospatialTaskCatalog::save() const
+{
+    QJsonObject catalogObject;
+    for (auto entryIterator = m_entries.constBegin(); entryIterator != m_entries.constEnd(); ++entryIterator)
+    {
+        CatalogEntry const &catalogEntry = entryIterator.value();
+        QJsonArray tasksArray;
+        foreach (GeospatialTaskInfo const &taskInfo, catalogEntry.taskInfos)
+        {
+            tasksArray.append(taskInfo.toJson());
+        }
+
+        QJsonObject entryObject;
+        entryObject.insert("size", QString::number(catalogEntry.size));
+        entryObject.insert("lastModified", catalogEntry.lastModified.toString(Qt::ISODateWithMs));
+        entryObject.insert("contentHash", QString::fromLatin1(catalogEntry.contentHash.toHex()));
+        entryObject.insert("tasks", tasksArray);
+        catalogObject.insert(entryIterator.key(), entryObject);
+    }
+
+    QFile catalogFile(catalogFilePath());
+    if (!catalogFile.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot save task catalog!";
+        return;
+    }
+
+    catalogFile.write(QJsonDocument(catalogObject).toJson(QJsonDocument::Compact));
+    catalogFile.close();
+}
+
+QList<GeospatialTaskInfo> GeospatialTaskCatalog::tasks(QFileInfo const &packageFileInfo)
+{
+    QString packageFilePath = packageFileInfo.absoluteFilePath();
+    if (!m_entries.contains(packageFilePath))
+    {
+        return QList<GeospatialTaskInfo>();
+    }
+
+    CatalogEntry &catalogEntry = m_entries[packageFilePath];
+    if (!validate(packageFileInfo, catalogEntry))
+    {
+        qDebug() << "Task catalog entry for" << packageFilePath << "is outdated.";
+        m_entries.remove(packageFilePath);
+        return QList<GeospatialTaskInfo>();
+    }
+
+    return catalogEntry.taskInfos;
+}
+
+void GeospatialTaskCatalog::update(QFileInfo const &packageFileInfo, QList<GeospatialTaskInfo> const &taskInfos)
+{
+    QString packageFilePath = packageFileInfo.absoluteFilePath();
+    CatalogEntry catalogEntry;
+    catalogEntry.size = packageFileInfo.size();
+    catalogEntry.lastModified = packageFileInfo.lastModified().toUTC();
+    catalogEntry.taskInfos = taskInfos;
+
+    // The stored hash is reused for an unchanged package, a changed one is hashed by the caller
+    if (m_entries.contains(packageFilePath))
+    {
+        CatalogEntry const &storedEntry = m_entries[packageFilePath];
+        if (storedEntry.size == catalogEntry.size
+                && storedEntry.lastModified == catalogEntry.lastModified)
+        {
+            catalogEntry.contentHash = storedEntry.contentHash;
+        }
+    }
+    m_entries.insert(packageFilePath, catalogEntry);
+}
+
+void GeospatialTaskCatalog::remove(QString const &packageFilePath)
+{
+    m_entries.remove(packageFilePath);
+}
+
+QByteArray GeospatialTaskCatalog::contentHash(QString const &packageFilePath) const
+{
+    // An unknown or not yet hashed package has no content hash
+    if (m_entries.contains(packageFilePath))
+    {
+        return m_entries[packageFilePath].contentHash;
+    }
+
+    return QByteArray();
+}
+
+bool GeospatialTaskCatalog::setContentHash(QFileInfo const &packageFileInfo, QByteArray const &contentHash)
+{
+    // The package may have been replaced while it was hashed
+    QString packageFilePath = packageFileInfo.absoluteFilePath();
+    if (!m_entries.contains(packageFilePath)
+            || contentHash.isEmpty())
+    {
+        return false;
+    }
+
+    CatalogEntry &catalogEntry = m_entries[packageFilePath];
+    if (catalogEntry.size != packageFileInfo.size()
+            || catalogEntry.lastModified != packageFileInfo.lastModified().toUTC())
+    {
+        return false;
+    }
+
+    catalogEntry.contentHash = contentHash;
+    return true;
+}
+
+bool GeospatialTaskCatalog::validate(QFileInfo const &packageFileInfo, CatalogEntry &catalogEntry) const
+{
+    if (!packageFileInfo.exists())
+    {
+        return false;
+    }
+
+    // Size and modification time unchanged, the stored hash is trusted
+    QDateTime lastModified = packageFileInfo.lastModified().toUTC();
+    if (packageFileInfo.size() == catalogEntry.size
+            && lastModified == catalogEntry.lastModified)
+    {
+        return true;
+    }
+
+    // The package was touched or copied, only the content decides
+    if (packageFileInfo.size() != catalogEntry.size
+            || computeContentHash(packageFileInfo.absoluteFilePath()) != catalogEntry.contentHash)
+    {
+        return false;
+    }
+
+    catalogEntry.lastModified = lastModified;
+    return true;
+}
+
+QByteArray GeospatialTaskCatalog::computeContentHash(QString const &packageFilePath)
+{
+    QFile packageFile(packageFilePath);
+    if (!packageFile.open(QIODevice::ReadOnly))
+    {
+        return QByteArray();
+    }
+
+    QCryptographicHash contentHash(QCryptographicHash::Sha1);
+    contentHash.addData(&packageFile);
+    return contentHash.result();
+}
@@ -0,0 +1,67 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALTASKCATALOG_H
+#define GEOSPATIALTASKCATALOG_H
+
+#include "GeospatialTaskInfo.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QMap>
+
+class GeospatialTaskCatalog
+{
+public:
+    GeospatialTaskCatalog();
+
+    void load();
+    void save() const;
+
+    QList<GeospatialTaskInfo> tasks(QFileInfo const &packageFileInfo);
+    void update(QFileInfo const &packageFileInfo, QList<GeospatialTaskInfo> const &taskInfos);
+    void remove(QString const &packageFilePath);
+
+    QByteArray contentHash(QString const &packageFilePath) const;
+    bool setContentHash(QFileInfo const &packageFileInfo, QByteArray const &contentHash);
+
+    static QByteArray computeContentHash(QString const &packageFilePath);
+
+private:
+    struct CatalogEntry {
+        qint64 size = 0;
+        QDateTime lastModified;
+        QByteArray contentHash;
+        QList<GeospatialTaskInfo> taskInfos;
+    };
+
+    QString catalogFilePath() const;
+    bool validate(QFileInfo const &packageFileInfo, CatalogEntry &catalogEntry) const;
+
+    QMap<QString, CatalogEntry> m_entries;
+};
+
+#endif // GEOSPATIALTASKCATALOG_H
@@ -0,0 +1,77 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALTASKCONTEXT_H
+#define GEOSPATIALTASKCONTEXT_H
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class ArcGISMapImageLayer;
+class FeatureCollection;
+class GeoprocessingFeatures;
+class GeoprocessingParameter;
+class GeoprocessingResult;
+}
+}
+
+#include "Geometry.h"
+
+#include <QDeadlineTimer>
+#include <QMap>
+#include <QString>
+#include <QUuid>
+
+#include <functional>
+
+// Receives the result instead of the taskCompleted signal, failed executions deliver no result at all
+typedef std::function<void(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult)> GeospatialResultSink;
+
+// Selects the executions to be cancelled
+struct GeospatialTaskContext;
+typedef std::function<bool(GeospatialTaskContext const &taskContext)> GeospatialTaskFilter;
+
+// Everything a single execution of a geospatial task needs
+struct GeospatialTaskContext
+{
+    QUuid requestId;
+    Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures = nullptr;
+    Esri::ArcGISRuntime::Geometry inputGeometry;
+    quint64 inputVersion = 0;
+    QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever);
+    QMap<QString, Esri::ArcGISRuntime::GeoprocessingParameter*> parameterOverrides;
+    // The result is read from the job on the server, it neither comes from the cache nor from a synchronous service
+    bool resultByReference = false;
+    GeospatialResultSink resultSink;
+
+    static GeospatialTaskContext create(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures, Esri::ArcGISRuntime::Geometry const &inputGeometry = Esri::ArcGISRuntime::Geometry(), quint64 inputVersion = 0);
+
+    // Executions without an input version are never superseded
+    bool isSupersededBy(quint64 currentInputVersion) const;
+    bool hasExpired() const;
+};
+
+#endif // GEOSPATIALTASKCONTEXT_H
@@ -0,0 +1,110 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialTaskInfo.h"
+
+#include "GeoprocessingParameterInfo.h"
+#include "GeoprocessingTaskInfo.h"
+
+#include <QJsonArray>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialParameterInfo GeospatialParameterInfo::fromParameterInfo(GeoprocessingParameterInfo const &parameterInfo)
+{
+    GeospatialParameterInfo geospatialParameterInfo;
+    geospatialParameterInfo.name = parameterInfo.name();
+    geospatialParameterInfo.displayName = parameterInfo.displayName();
+    geospatialParameterInfo.description = parameterInfo.description();
+    geospatialParameterInfo.direction = parameterInfo.direction();
+    geospatialParameterInfo.dataType = parameterInfo.dataType();
+    return geospatialParameterInfo;
+}
+
+GeospatialParameterInfo GeospatialParameterInfo::fromJson(QJsonObject const &parameterObject)
+{
+    GeospatialParameterInfo geospatialParameterInfo;
+    geospatialParameterInfo.name = parameterObject["name"].toString();
+    geospatialParameterInfo.displayName = parameterObject["displayName"].toString();
+    geospatialParameterInfo.description = parameterObject["description"].toString();
+    geospatialParameterInfo.direction = static_cast<GeoprocessingParameterDirection>(parameterObject["direction"].toInt());
+    geospatialParameterInfo.dataType = static_cast<GeoprocessingParameterType>(parameterObject["dataType"].toInt());
+    return geospatialParameterInfo;
+}
+
+QJsonObject GeospatialParameterInfo::toJson() const
+{
+    QJsonObject parameterObject;
+    parameterObject.insert("name", name);
+    parameterObject.insert("displayName", displayName);
+    parameterObject.insert("description", description);
+    parameterObject.insert("direction", static_cast<int>(direction));
+    parameterObject.insert("dataType", static_cast<int>(dataType));
+    return parameterObject;
+}
+
+GeospatialTaskInfo GeospatialTaskInfo::fromTaskInfo(GeoprocessingTaskInfo const &taskInfo, GeoprocessingServiceType serviceType)
+{
+    GeospatialTaskInfo geospatialTaskInfo;
+    geospatialTaskInfo.name = taskInfo.name();
+    geospatialTaskInfo.displayName = taskInfo.displayName();
+    geospatialTaskInfo.description = taskInfo.description();
+    geospatialTaskInfo.serviceType = serviceType;
+    foreach (GeoprocessingParameterInfo const &parameterInfo, taskInfo.parameterInfos())
+    {
+        geospatialTaskInfo.parameters.append(GeospatialParameterInfo::fromParameterInfo(parameterInfo));
+    }
+    return geospatialTaskInfo;
+}
+
+GeospatialTaskInfo GeospatialTaskInfo::fromJson(QJsonObject const &taskObject)
+{
+    GeospatialTaskInfo geospatialTaskInfo;
+    geospatialTaskInfo.name = taskObject["name"].toString();
+    geospatialTaskInfo.displayName = taskObject["displayName"].toString();
+    geospatialTaskInfo.description = taskObject["description"].toString();
+    geospatialTaskInfo.serviceType = static_cast<GeoprocessingServiceType>(taskObject["serviceType"].toInt());
+    foreach (QJsonValue const &parameterValue, taskObject["parameters"].toArray())
+    {
+        geospatialTaskInfo.parameters.append(GeospatialParameterInfo::fromJson(parameterValue.toObject()));
+    }
+    return geospatialTaskInfo;
+}
+
+QJsonObject GeospatialTaskInfo::toJson() const
+{
+    QJsonArray parametersArray;
+    foreach (GeospatialParameterInfo const &parameterInfo, parameters)
+    {
+        parametersArray.append(parameterInfo.toJson());
+    }
+
+    QJsonObject taskObject;
+    taskObject.insert("name", name);
+    taskObject.insert("displayName", displayName);
+    taskObject.insert("description", description);
+    taskObject.insert("serviceType", static_cast<int>(serviceType));
+    taskObject.insert("parameters", parametersArray);
+    return taskObject;
+}
@@ -0,0 +1,71 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALTASKINFO_H
+#define GEOSPATIALTASKINFO_H
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class GeoprocessingParameterInfo;
+class GeoprocessingTaskInfo;
+}
+}
+
+#include "GeoprocessingTypes.h"
+#include "LocalServerTypes.h"
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+struct GeospatialParameterInfo
+{
+    QString name;
+    QString displayName;
+    QString description;
+    Esri::ArcGISRuntime::GeoprocessingParameterDirection direction = Esri::ArcGISRuntime::GeoprocessingParameterDirection::Input;
+    Esri::ArcGISRuntime::GeoprocessingParameterType dataType = Esri::ArcGISRuntime::GeoprocessingParameterType::GeoprocessingUnknownParameter;
+
+    static GeospatialParameterInfo fromParameterInfo(Esri::ArcGISRuntime::GeoprocessingParameterInfo const &parameterInfo);
+    static GeospatialParameterInfo fromJson(QJsonObject const &parameterObject);
+    QJsonObject toJson() const;
+};
+
+struct GeospatialTaskInfo
+{
+    QString name;
+    QString displayName;
+    QString description;
+    Esri::ArcGISRuntime::GeoprocessingServiceType serviceType = Esri::ArcGISRuntime::GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult;
+    QList<GeospatialParameterInfo> parameters;
+
+    static GeospatialTaskInfo fromTaskInfo(Esri::ArcGISRuntime::GeoprocessingTaskInfo const &taskInfo, Esri::ArcGISRuntime::GeoprocessingServiceType serviceType);
+    static GeospatialTaskInfo fromJson(QJsonObject const &taskObject);
+    QJsonObject toJson() const;
+};
+
+#endif // GEOSPATIALTASKINFO_H
@@ -34,6 +34,30 @@ void GeospatialTaskListModel::addTask(LocalGeospatialTask *geospatialTask)
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_geospatialTasks.append(geospatialTask);
     endInsertRows();
+
+    // The execution policy follows the measured latencies
+    connect(geospatialTask, &LocalGeospatialTask::executionStatisticsChanged, this, [this, geospatialTask]()
+    {
+        int taskIndex = m_geospatialTasks.indexOf(geospatialTask);
+        if (-1 != taskIndex)
+        {
+            emit dataChanged(index(taskIndex), index(taskIndex), QVector<int>() << RoleNames::ExecutionPolicyRole);
+        }
+    });
+}
+
+void GeospatialTaskListModel::removeTask(LocalGeospatialTask *geospatialTask)
+{
+    int taskIndex = m_geospatialTasks.indexOf(geospatialTask);
+    if (-1 == taskIndex)
+    {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), taskIndex, taskIndex);
+    disconnect(geospatialTask, nullptr, this, nullptr);
+    m_geospatialTasks.removeAt(taskIndex);
+    endRemoveRows();
 }
 
 LocalGeospatialTask* GeospatialTaskListModel::task(int taskIndex) const
@@ -52,6 +76,7 @@ QHash<int, QByteArray> GeospatialTaskListModel::roleNames() const
     QHash<int, QByteArray> roles;
     roles.insert(RoleNames::TitleRole, QString("title").toUtf8());
     roles.insert(RoleNames::DescriptionRole, QString("description").toUtf8());
+    roles.insert(RoleNames::ExecutionPolicyRole, QString("executionPolicy").toUtf8());
     return roles;
 }
 
@@ -79,6 +104,18 @@ QVariant GeospatialTaskListModel::data(const QModelIndex &index, int role) const
         qDebug() << "description:" << geospatialTask->description();
         return geospatialTask->description();
 
+    case ExecutionPolicyRole:
+        {
+            LocalGeospatialTask::ExecutionMode executionMode = geospatialTask->executionMode();
+            QString executionPolicy = (LocalGeospatialTask::ExecutionMode::Synchronous == executionMode) ? tr("Synchronous execute") : tr("Asynchronous submit");
+            qint64 averageLatency = geospatialTask->averageLatency(executionMode);
+            if (0 < averageLatency)
+            {
+                executionPolicy += tr(", %1 ms average").arg(averageLatency);
+            }
+            return executionPolicy;
+        }
+
     default:
         qDebug() << "Unknown role!";
         return QVariant();
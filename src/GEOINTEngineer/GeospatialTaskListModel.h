@@ -38,6 +38,7 @@ public:
     explicit GeospatialTaskListModel(QObject *parent = nullptr);
 
     Q_INVOKABLE void addTask(LocalGeospatialTask *geospatialTask);
+    Q_INVOKABLE void removeTask(LocalGeospatialTask *geospatialTask);
     Q_INVOKABLE LocalGeospatialTask* task(int taskIndex) const;
 
     QHash<int, QByteArray> roleNames() const override;
@@ -49,7 +50,8 @@ signals:
 private:
     enum RoleNames {
         TitleRole = Qt::UserRole + 1,
-        DescriptionRole = Qt::UserRole + 2
+        DescriptionRole = Qt::UserRole + 2,
+        ExecutionPolicyRole = Qt::UserRole + 3
     };
 
     QList<LocalGeospatialTask*> m_geospatialTasks;
@@ -25,7 +25,6 @@
 #include "GeospatialTaskParameterModel.h"
 #include "LocalGeospatialTask.h"
 
-#include "GeoprocessingParameterInfo.h"
 #include "GeoprocessingTypes.h"
 
 using namespace Esri::ArcGISRuntime;
@@ -39,9 +38,119 @@ void GeospatialTaskParameterModel::updateParameters(LocalGeospatialTask *localGe
 {
     beginResetModel();
     m_localGeospatialTask = localGeospatialTask;
+    m_parameterValues.clear();
+    m_dateValues.clear();
     endResetModel();
 }
 
+void GeospatialTaskParameterModel::setParameterValue(int parameterIndex, QString const &valueText, QString const &unit)
+{
+    GeospatialParameterInfo parameterInfo = inputParameterInfo(parameterIndex);
+    if (parameterInfo.name.isEmpty()
+            || !GeospatialParameterSweep::isSweepable(parameterInfo.dataType))
+    {
+        return;
+    }
+
+    // An empty value keeps the default of the task
+    GeospatialParameterSweep parameterValue;
+    parameterValue.parameterName = parameterInfo.name;
+    parameterValue.dataType = parameterInfo.dataType;
+    parameterValue.values = GeospatialParameterSweep::parseValues(valueText);
+    parameterValue.unit = unit;
+    if (parameterValue.values.isEmpty())
+    {
+        m_parameterValues.remove(parameterInfo.name);
+        return;
+    }
+
+    m_parameterValues.insert(parameterInfo.name, parameterValue);
+}
+
+void GeospatialTaskParameterModel::setDateValue(int parameterIndex, QString const &valueText, int windowCount)
+{
+    GeospatialParameterInfo parameterInfo = inputParameterInfo(parameterIndex);
+    if (parameterInfo.name.isEmpty()
+            || GeoprocessingParameterType::GeoprocessingDate != parameterInfo.dataType)
+    {
+        return;
+    }
+
+    // An empty value keeps the default of the task
+    GeospatialTimeWindows dateValue = GeospatialTimeWindows::parse(valueText);
+    if (!dateValue.start.isValid())
+    {
+        m_dateValues.remove(parameterInfo.name);
+        return;
+    }
+
+    dateValue.parameterName = parameterInfo.name;
+    dateValue.endParameterName = endDateParameterName(parameterInfo.name);
+    dateValue.windowCount = qBound(1, windowCount, GeospatialTimeWindows::MaximumWindowCount);
+    m_dateValues.insert(parameterInfo.name, dateValue);
+}
+
+QList<GeospatialParameterSweep> GeospatialTaskParameterModel::parameterValues() const
+{
+    return m_parameterValues.values();
+}
+
+QList<GeospatialTimeWindows> GeospatialTaskParameterModel::dateValues() const
+{
+    return m_dateValues.values();
+}
+
+QString GeospatialTaskParameterModel::endDateParameterName(QString const &startParameterName) const
+{
+    // A date range entered for the first date input also sets the following date input
+    bool startParameterFound = false;
+    foreach (const GeospatialParameterInfo &parameterInfo, m_localGeospatialTask->parameters())
+    {
+        if (GeoprocessingParameterDirection::Input != parameterInfo.direction
+                || GeoprocessingParameterType::GeoprocessingDate != parameterInfo.dataType)
+        {
+            continue;
+        }
+
+        if (startParameterFound)
+        {
+            return parameterInfo.name;
+        }
+        startParameterFound = (startParameterName == parameterInfo.name);
+    }
+
+    return QString();
+}
+
+GeospatialParameterInfo GeospatialTaskParameterModel::inputParameterInfo(int parameterIndex) const
+{
+    if (nullptr == m_localGeospatialTask)
+    {
+        return GeospatialParameterInfo();
+    }
+
+    int inputParameterIndex = -1;
+    foreach (const GeospatialParameterInfo &parameterInfo, m_localGeospatialTask->parameters())
+    {
+        switch (parameterInfo.direction)
+        {
+        case GeoprocessingParameterDirection::Input:
+            inputParameterIndex++;
+            break;
+
+        default:
+            break;
+        }
+
+        if (parameterIndex == inputParameterIndex)
+        {
+            return parameterInfo;
+        }
+    }
+
+    return GeospatialParameterInfo();
+}
+
 QHash<int, QByteArray> GeospatialTaskParameterModel::roleNames() const
 {
     QHash<int, QByteArray> roleNames;
@@ -58,9 +167,9 @@ int GeospatialTaskParameterModel::rowCount(const QModelIndex &parent) const
     }
 
     int inputParameterCount = 0;
-    foreach (const GeoprocessingParameterInfo &parameterInfo, m_localGeospatialTask->parameters())
+    foreach (const GeospatialParameterInfo &parameterInfo, m_localGeospatialTask->parameters())
     {
-        switch (parameterInfo.direction())
+        switch (parameterInfo.direction)
         {
         case GeoprocessingParameterDirection::Input:
             inputParameterCount++;
@@ -81,34 +190,15 @@ QVariant GeospatialTaskParameterModel::data(const QModelIndex &index, int role)
         return QVariant();
     }
 
-    int inputParameterIndex = -1;
-    GeoprocessingParameterInfo inputParameterInfo;
-    foreach (const GeoprocessingParameterInfo &parameterInfo, m_localGeospatialTask->parameters())
-    {
-        switch (parameterInfo.direction())
-        {
-        case GeoprocessingParameterDirection::Input:
-            inputParameterIndex++;
-            break;
-
-        default:
-            break;
-        }
-
-        if (index.row() == inputParameterIndex)
-        {
-            inputParameterInfo = parameterInfo;
-            break;
-        }
-    }
+    GeospatialParameterInfo inputParameterInfo = this->inputParameterInfo(index.row());
 
     switch (role)
     {
     case ParameterNameRole:
-        return inputParameterInfo.displayName();
+        return inputParameterInfo.displayName;
 
     case UiEditorRole:
-        switch (inputParameterInfo.dataType())
+        switch (inputParameterInfo.dataType)
         {
         case GeoprocessingParameterType::GeoprocessingFeatures:
             return "GpFeaturesInput.qml";
@@ -116,6 +206,15 @@ QVariant GeospatialTaskParameterModel::data(const QModelIndex &index, int role)
         case GeoprocessingParameterType::GeoprocessingLinearUnit:
             return "GpLinearUnitInput.qml";
 
+        case GeoprocessingParameterType::GeoprocessingDate:
+            return "GpDateInput.qml";
+
+        case GeoprocessingParameterType::GeoprocessingDouble:
+            return "GpDoubleInput.qml";
+
+        case GeoprocessingParameterType::GeoprocessingLong:
+            return "GpLongInput.qml";
+
         default:
             return "GpStringInput.qml";
         }
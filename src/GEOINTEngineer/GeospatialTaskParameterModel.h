@@ -26,7 +26,12 @@
 #ifndef GEOSPATIALTASKPARAMETERMODEL_H
 #define GEOSPATIALTASKPARAMETERMODEL_H
 
+#include "GeospatialParameterSweep.h"
+#include "GeospatialTaskInfo.h"
+#include "GeospatialTimeWindows.h"
+
 #include <QAbstractListModel>
+#include <QMap>
 #include <QObject>
 
 class LocalGeospatialTask;
@@ -37,9 +42,21 @@ class GeospatialTaskParameterModel : public QAbstractListModel
 
     Q_OBJECT
 public:
+    // The date editors offer as many time windows as an execution accepts
+    enum Limits {
+        MaximumWindowCount = GeospatialTimeWindows::MaximumWindowCount
+    };
+    Q_ENUM(Limits)
+
     explicit GeospatialTaskParameterModel(QObject *parent = nullptr);
 
     Q_INVOKABLE void updateParameters(LocalGeospatialTask *localGeospatialTask);
+    Q_INVOKABLE void setParameterValue(int parameterIndex, QString const &valueText, QString const &unit = QString());
+
+    Q_INVOKABLE void setDateValue(int parameterIndex, QString const &valueText, int windowCount = 1);
+
+    QList<GeospatialParameterSweep> parameterValues() const;
+    QList<GeospatialTimeWindows> dateValues() const;
 
     QHash<int, QByteArray> roleNames() const override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -51,6 +68,8 @@ signals:
 private:
     bool isPolygonSketchToolActivated() const;
     void setPolygonSketchToolActivated(bool activated);
+    GeospatialParameterInfo inputParameterInfo(int parameterIndex) const;
+    QString endDateParameterName(QString const &startParameterName) const;
 
     enum RoleNames {
         ParameterNameRole = Qt::UserRole + 1,
@@ -58,6 +77,8 @@ private:
     };
 
     LocalGeospatialTask *m_localGeospatialTask = nullptr;
+    QMap<QString, GeospatialParameterSweep> m_parameterValues;
+    QMap<QString, GeospatialTimeWindows> m_dateValues;
     bool m_polygonSketchToolActivated = false;
 };
 
@@ -0,0 +1,340 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialResultCache.h"
+#include "GeospatialTiledExecution.h"
+#include "LocalGeospatialTask.h"
+
+#include "AttributeListModel.h"
+#include "Feature.h"
+#include "FeatureCollection.h"
+#include "FeatureCollectionTable.h"
+#include "FeatureIterator.h"
+#include "FeatureSet.h"
+#include "Field.h"
+#include "GeometryEngine.h"
+#include "GeometryTypes.h"
+#include "GeoprocessingFeatures.h"
+#include "Point.h"
+#include "SpatialReference.h"
+
+#include <QDebug>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QTimer>
+#include <QtMath>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialTiledExecution::GeospatialTiledExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, int tileCount, double tileOverlap, QObject *parent) :
+    QObject(parent),
+    m_geospatialTask(geospatialTask),
+    m_taskContext(taskContext),
+    m_tileCount(tileCount),
+    m_tileOverlap(tileOverlap)
+{
+}
+
+void GeospatialTiledExecution::start()
+{
+    // The cells follow the aspect ratio of the area
+    m_extent = m_taskContext.inputGeometry.extent();
+    double aspectRatio = (0 < m_extent.height()) ? m_extent.width() / m_extent.height() : 1.0;
+    m_columnCount = qBound(1, qRound(qSqrt(m_tileCount * aspectRatio)), m_tileCount);
+    m_rowCount = qMax(1, (m_tileCount + m_columnCount - 1) / m_columnCount);
+    double cellWidth = m_extent.width() / m_columnCount;
+    double cellHeight = m_extent.height() / m_rowCount;
+
+    // The tile inputs use the schema and the attributes of the original input features
+    QList<Field> inputFields;
+    GeometryType geometryType = GeometryType::Polygon;
+    FeatureSet *inputFeatureSet = (nullptr != m_taskContext.inputFeatures) ? m_taskContext.inputFeatures->features() : nullptr;
+    if (nullptr != inputFeatureSet)
+    {
+        inputFields = inputFeatureSet->fields();
+        geometryType = inputFeatureSet->geometryType();
+    }
+    QList<InputFeature> inputFeatures = readInputFeatures();
+
+    SpatialReference spatialReference = m_taskContext.inputGeometry.spatialReference();
+    for (int row = 0; row < m_rowCount; row++)
+    {
+        for (int column = 0; column < m_columnCount; column++)
+        {
+            // Neighbouring tiles overlap, so that features on a cell boundary are found by both
+            double xMin = m_extent.xMin() + column * cellWidth - m_tileOverlap * cellWidth;
+            double yMin = m_extent.yMin() + row * cellHeight - m_tileOverlap * cellHeight;
+            double xMax = m_extent.xMin() + (column + 1) * cellWidth + m_tileOverlap * cellWidth;
+            double yMax = m_extent.yMin() + (row + 1) * cellHeight + m_tileOverlap * cellHeight;
+            Envelope tileEnvelope(xMin, yMin, xMax, yMax, spatialReference);
+            Geometry tileGeometry = GeometryEngine::intersection(m_taskContext.inputGeometry, tileEnvelope);
+            if (tileGeometry.isEmpty())
+            {
+                continue;
+            }
+
+            // Every input feature is clipped by the tile and keeps its attributes,
+            // without input features the tile area itself is the input
+            QList<Feature*> tileFeatures;
+            FeatureCollectionTable *inputTable = new FeatureCollectionTable(inputFields, geometryType, spatialReference, this);
+            foreach (InputFeature const &inputFeature, inputFeatures)
+            {
+                Geometry featureGeometry = inputFeature.geometry;
+                if (!featureGeometry.spatialReference().isEmpty()
+                        && featureGeometry.spatialReference() != spatialReference)
+                {
+                    featureGeometry = GeometryEngine::project(featureGeometry, spatialReference);
+                }
+
+                Geometry clippedGeometry = GeometryEngine::intersection(featureGeometry, tileEnvelope);
+                if (!clippedGeometry.isEmpty())
+                {
+                    tileFeatures.append(inputTable->createFeature(inputFeature.attributes, clippedGeometry, this));
+                }
+            }
+            if (nullptr == inputFeatureSet)
+            {
+                Feature *tileFeature = inputTable->createFeature(this);
+                tileFeature->setGeometry(tileGeometry);
+                tileFeatures.append(tileFeature);
+            }
+            if (tileFeatures.isEmpty())
+            {
+                inputTable->deleteLater();
+                continue;
+            }
+
+            Tile tile;
+            tile.column = column;
+            tile.row = row;
+            tile.geometry = tileGeometry;
+            tile.inputTable = inputTable;
+            tile.pendingFeatures = tileFeatures.size();
+            QUuid tileRequestId = QUuid::createUuid();
+            m_tiles.insert(tileRequestId, tile);
+
+            connect(inputTable, &FeatureCollectionTable::addFeatureCompleted, this, [this, tileRequestId](QUuid, bool added)
+            {
+                tileFeatureAdded(tileRequestId, added);
+            });
+            foreach (Feature *tileFeature, tileFeatures)
+            {
+                inputTable->addFeature(tileFeature);
+            }
+        }
+    }
+
+    qDebug() << "Execution request" << m_taskContext.requestId << "of" << m_geospatialTask->name() << "split into" << m_tiles.size() << "tiles.";
+    if (m_tiles.isEmpty())
+    {
+        QTimer::singleShot(0, this, &GeospatialTiledExecution::finish);
+    }
+}
+
+QList<GeospatialTiledExecution::InputFeature> GeospatialTiledExecution::readInputFeatures() const
+{
+    QList<InputFeature> inputFeatures;
+    if (nullptr == m_taskContext.inputFeatures
+            || nullptr == m_taskContext.inputFeatures->features())
+    {
+        return inputFeatures;
+    }
+
+    QObject lifetimeManager;
+    FeatureIterator featureIterator = m_taskContext.inputFeatures->features()->iterator();
+    while (featureIterator.hasNext())
+    {
+        Feature *feature = featureIterator.next(&lifetimeManager);
+        InputFeature inputFeature;
+        inputFeature.attributes = feature->attributes()->attributesMap();
+        inputFeature.geometry = feature->geometry();
+        inputFeatures.append(inputFeature);
+    }
+
+    return inputFeatures;
+}
+
+void GeospatialTiledExecution::tileFeatureAdded(QUuid const &tileRequestId, bool added)
+{
+    // The tile may have failed already
+    if (!m_tiles.contains(tileRequestId))
+    {
+        return;
+    }
+
+    if (!added)
+    {
+        qDebug() << "Adding an input feature of tile" << tileRequestId << "failed!";
+        completeTile(tileRequestId, nullptr, nullptr);
+        return;
+    }
+
+    Tile &tile = m_tiles[tileRequestId];
+    tile.pendingFeatures--;
+    if (0 < tile.pendingFeatures)
+    {
+        return;
+    }
+
+    GeospatialTaskContext tileContext = m_taskContext;
+    tileContext.requestId = tileRequestId;
+    tileContext.inputFeatures = new GeoprocessingFeatures(tile.inputTable, this);
+    tileContext.inputGeometry = tile.geometry;
+
+    // The tile results are merged instead of being reported
+    QPointer<GeospatialTiledExecution> tiledExecution(this);
+    tileContext.resultSink = [tiledExecution](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer*, FeatureCollection *featureCollectionResult)
+    {
+        if (!tiledExecution.isNull())
+        {
+            tiledExecution->completeTile(requestId, result, featureCollectionResult);
+        }
+    };
+    emit tileReady(m_geospatialTask, tileContext);
+}
+
+void GeospatialTiledExecution::completeTile(QUuid const &tileRequestId, GeoprocessingResult *result, FeatureCollection *featureCollectionResult)
+{
+    if (!m_tiles.contains(tileRequestId))
+    {
+        return;
+    }
+
+    Tile tile = m_tiles.take(tileRequestId);
+    if (nullptr != featureCollectionResult)
+    {
+        mergeFeatures(tile, featureCollectionResult->toJson());
+        featureCollectionResult->deleteLater();
+    }
+    else if (nullptr != result)
+    {
+        mergeFeatures(tile, GeospatialResultCache::featureCollectionJson(result));
+    }
+    else
+    {
+        qDebug() << "Tile" << tileRequestId << "of execution request" << m_taskContext.requestId << "failed!";
+    }
+
+    if (m_tiles.isEmpty())
+    {
+        finish();
+    }
+}
+
+void GeospatialTiledExecution::mergeFeatures(Tile const &tile, QString const &featureCollectionJson)
+{
+    QJsonDocument collectionDocument = QJsonDocument::fromJson(featureCollectionJson.toUtf8());
+    if (!collectionDocument.isObject())
+    {
+        return;
+    }
+
+    // The outputs of every tile have the same layers in the same order
+    QJsonObject collectionObject = collectionDocument.object();
+    QJsonArray layersArray = collectionObject["layers"].toArray();
+    if (m_mergedCollection.isEmpty())
+    {
+        m_mergedCollection = collectionObject;
+    }
+
+    for (int layerIndex = 0, layerCount = layersArray.size(); layerIndex < layerCount; layerIndex++)
+    {
+        QJsonObject layerObject = layersArray[layerIndex].toObject();
+        QJsonObject featureSetObject = layerObject["featureSet"].toObject();
+        QJsonValue spatialReference = featureSetObject["spatialReference"];
+        if (m_mergedLayers.size() <= layerIndex)
+        {
+            QJsonObject mergedFeatureSetObject = featureSetObject;
+            mergedFeatureSetObject.insert("features", QJsonArray());
+            layerObject.insert("featureSet", mergedFeatureSetObject);
+            m_mergedLayers.append(layerObject);
+        }
+
+        QJsonObject mergedLayerObject = m_mergedLayers[layerIndex].toObject();
+        QJsonObject mergedFeatureSetObject = mergedLayerObject["featureSet"].toObject();
+        QJsonArray mergedFeaturesArray = mergedFeatureSetObject["features"].toArray();
+        foreach (QJsonValue const &featureValue, featureSetObject["features"].toArray())
+        {
+            if (ownsFeature(tile, featureValue.toObject(), spatialReference))
+            {
+                mergedFeaturesArray.append(featureValue);
+            }
+        }
+        mergedFeatureSetObject.insert("features", mergedFeaturesArray);
+        mergedLayerObject.insert("featureSet", mergedFeatureSetObject);
+        m_mergedLayers.replace(layerIndex, mergedLayerObject);
+    }
+}
+
+bool GeospatialTiledExecution::ownsFeature(Tile const &tile, QJsonObject const &featureObject, QJsonValue const &spatialReference) const
+{
+    QJsonObject geometryObject = featureObject["geometry"].toObject();
+    if (geometryObject.isEmpty())
+    {
+        return true;
+    }
+
+    if (!geometryObject.contains("spatialReference")
+            && spatialReference.isObject())
+    {
+        geometryObject.insert("spatialReference", spatialReference);
+    }
+
+    Geometry featureGeometry = Geometry::fromJson(QString::fromUtf8(QJsonDocument(geometryObject).toJson(QJsonDocument::Compact)));
+    if (featureGeometry.isEmpty())
+    {
+        return true;
+    }
+
+    // Features found by overlapping tiles belong to the cell containing their center
+    Point featureCenter = featureGeometry.extent().center();
+    if (!featureCenter.spatialReference().isEmpty()
+            && featureCenter.spatialReference() != m_extent.spatialReference())
+    {
+        featureCenter = Point(GeometryEngine::project(featureCenter, m_extent.spatialReference()));
+    }
+
+    double cellWidth = m_extent.width() / m_columnCount;
+    double cellHeight = m_extent.height() / m_rowCount;
+    int column = (0 < cellWidth) ? qBound(0, qFloor((featureCenter.x() - m_extent.xMin()) / cellWidth), m_columnCount - 1) : 0;
+    int row = (0 < cellHeight) ? qBound(0, qFloor((featureCenter.y() - m_extent.yMin()) / cellHeight), m_rowCount - 1) : 0;
+    return column == tile.column && row == tile.row;
+}
+
+void GeospatialTiledExecution::finish()
+{
+    FeatureCollection *mergedFeatures = nullptr;
+    if (!m_mergedLayers.isEmpty())
+    {
+        m_mergedCollection.insert("layers", m_mergedLayers);
+        mergedFeatures = FeatureCollection::fromJson(QString::fromUtf8(QJsonDocument(m_mergedCollection).toJson(QJsonDocument::Compact)), this);
+    }
+    if (nullptr == mergedFeatures)
+    {
+        mergedFeatures = new FeatureCollection(this);
+    }
+
+    qDebug() << "Tiles of execution request" << m_taskContext.requestId << "merged.";
+    emit executionCompleted(m_taskContext.requestId, mergedFeatures);
+}
@@ -0,0 +1,98 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef GEOSPATIALTILEDEXECUTION_H
+#define GEOSPATIALTILEDEXECUTION_H
+
+class LocalGeospatialTask;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class FeatureCollection;
+class FeatureCollectionTable;
+class GeoprocessingResult;
+}
+}
+
+#include "GeospatialTaskContext.h"
+
+#include "Envelope.h"
+#include "Geometry.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QUuid>
+#include <QVariantMap>
+
+class GeospatialTiledExecution : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GeospatialTiledExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, int tileCount, double tileOverlap, QObject *parent = nullptr);
+
+    void start();
+
+signals:
+    void tileReady(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &tileContext);
+    void executionCompleted(QUuid const &requestId, Esri::ArcGISRuntime::FeatureCollection *mergedFeatures);
+
+private:
+    struct Tile {
+        int column = 0;
+        int row = 0;
+        Esri::ArcGISRuntime::Geometry geometry;
+        Esri::ArcGISRuntime::FeatureCollectionTable *inputTable = nullptr;
+        int pendingFeatures = 0;
+    };
+
+    struct InputFeature {
+        QVariantMap attributes;
+        Esri::ArcGISRuntime::Geometry geometry;
+    };
+
+    QList<InputFeature> readInputFeatures() const;
+    void tileFeatureAdded(QUuid const &tileRequestId, bool added);
+    void completeTile(QUuid const &tileRequestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    void mergeFeatures(Tile const &tile, QString const &featureCollectionJson);
+    bool ownsFeature(Tile const &tile, QJsonObject const &featureObject, QJsonValue const &spatialReference) const;
+    void finish();
+
+    LocalGeospatialTask *m_geospatialTask;
+    GeospatialTaskContext m_taskContext;
+    int m_tileCount;
+    double m_tileOverlap;
+    Esri::ArcGISRuntime::Envelope m_extent;
+    int m_columnCount = 1;
+    int m_rowCount = 1;
+    QMap<QUuid, Tile> m_tiles;
+    QJsonObject m_mergedCollection;
+    QJsonArray m_mergedLayers;
+};
+
+#endif // GEOSPATIALTILEDEXECUTION_H
@@ -0,0 +1,112 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialSweepExecution.h"
+#include "GeospatialTimeSlicedExecution.h"
+#include "LocalGeospatialTask.h"
+
+#include "ArcGISMapImageLayer.h"
+#include "FeatureCollection.h"
+#include "GeoprocessingParameter.h"
+#include "GeoprocessingResult.h"
+#include "GroupLayer.h"
+#include "Layer.h"
+
+#include <QDebug>
+#include <QPointer>
+
+using namespace Esri::ArcGISRuntime;
+
+GeospatialTimeSlicedExecution::GeospatialTimeSlicedExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialTimeWindows const &timeWindows, QObject *parent) :
+    QObject(parent),
+    m_geospatialTask(geospatialTask),
+    m_taskContext(taskContext),
+    m_timeWindows(timeWindows)
+{
+}
+
+void GeospatialTimeSlicedExecution::start()
+{
+    // Every window shares the input features and differs by its dates only
+    QList<GeospatialTaskContext> windowContexts;
+    QPointer<GeospatialTimeSlicedExecution> timeSlicedExecution(this);
+    foreach (GeospatialTimeWindow const &window, m_timeWindows.windows())
+    {
+        GeospatialTaskContext windowContext = m_taskContext;
+        windowContext.requestId = QUuid::createUuid();
+        QMap<QString, GeoprocessingParameter*> windowParameters = m_timeWindows.createParameters(window, this);
+        for (auto parameterIterator = windowParameters.constBegin(); parameterIterator != windowParameters.constEnd(); ++parameterIterator)
+        {
+            windowContext.parameterOverrides.insert(parameterIterator.key(), parameterIterator.value());
+        }
+        windowContext.resultSink = [timeSlicedExecution](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+        {
+            if (!timeSlicedExecution.isNull())
+            {
+                timeSlicedExecution->completeWindow(requestId, result, mapImageLayerResult, featureCollectionResult);
+            }
+        };
+        m_windows.insert(windowContext.requestId, window);
+        windowContexts.append(windowContext);
+    }
+
+    qDebug() << "Execution request" << m_taskContext.requestId << "of" << m_geospatialTask->name() << "slices" << m_timeWindows.parameterName << "into" << windowContexts.size() << "time windows.";
+    foreach (GeospatialTaskContext const &windowContext, windowContexts)
+    {
+        emit windowReady(m_geospatialTask, windowContext);
+    }
+}
+
+void GeospatialTimeSlicedExecution::completeWindow(QUuid const &windowRequestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+{
+    if (!m_windows.contains(windowRequestId))
+    {
+        return;
+    }
+
+    // Every window is streamed as a layer named by its time span as soon as it completes
+    GeospatialTimeWindow window = m_windows.take(windowRequestId);
+    Layer *windowLayer = GeospatialSweepExecution::createResultLayer(result, mapImageLayerResult, featureCollectionResult, this);
+    if (nullptr == windowLayer)
+    {
+        qDebug() << "Time window" << GeospatialTimeWindows::windowLabel(window) << "of execution request" << m_taskContext.requestId << "failed!";
+    }
+    else
+    {
+        if (m_groupLayer.isNull())
+        {
+            m_groupLayer = new GroupLayer(QList<Layer*>(), this);
+            m_groupLayer->setName(QString("%1 (%2)").arg(m_geospatialTask->displayName(), m_timeWindows.parameterName));
+        }
+
+        windowLayer->setName(GeospatialTimeWindows::windowLabel(window));
+        emit windowCompleted(m_taskContext.requestId, m_groupLayer, windowLayer);
+    }
+
+    if (m_windows.isEmpty())
+    {
+        qDebug() << "Time-sliced execution request" << m_taskContext.requestId << "completed.";
+        emit executionCompleted(m_taskContext.requestId);
+    }
+}
@@ -0,0 +1,74 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALTIMESLICEDEXECUTION_H
+#define GEOSPATIALTIMESLICEDEXECUTION_H
+
+class LocalGeospatialTask;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class ArcGISMapImageLayer;
+class FeatureCollection;
+class GeoprocessingResult;
+class GroupLayer;
+class Layer;
+}
+}
+
+#include "GeospatialTaskContext.h"
+#include "GeospatialTimeWindows.h"
+
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QUuid>
+
+class GeospatialTimeSlicedExecution : public QObject
+{
+    Q_OBJECT
+public:
+    explicit GeospatialTimeSlicedExecution(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialTimeWindows const &timeWindows, QObject *parent = nullptr);
+
+    void start();
+
+signals:
+    void windowReady(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &windowContext);
+    void windowCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer, Esri::ArcGISRuntime::Layer *windowLayer);
+    void executionCompleted(QUuid const &requestId);
+
+private:
+    void completeWindow(QUuid const &windowRequestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+
+    LocalGeospatialTask *m_geospatialTask;
+    GeospatialTaskContext m_taskContext;
+    GeospatialTimeWindows m_timeWindows;
+    QMap<QUuid, GeospatialTimeWindow> m_windows;
+    // The group layer is deleted as soon as the user removes the results
+    QPointer<Esri::ArcGISRuntime::GroupLayer> m_groupLayer;
+};
+
+#endif // GEOSPATIALTIMESLICEDEXECUTION_H
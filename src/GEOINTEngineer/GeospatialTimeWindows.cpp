@@ -0,0 +1,129 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "GeospatialTimeWindows.h"
+
+#include "GeoprocessingDate.h"
+
+#include <QDate>
+#include <QDebug>
+#include <QStringList>
+
+using namespace Esri::ArcGISRuntime;
+
+QDateTime GeospatialTimeWindows::parseDateTime(QString const &dateText)
+{
+    QDateTime dateTime = QDateTime::fromString(dateText.trimmed(), Qt::ISODate);
+    if (!dateTime.isValid())
+    {
+        QDate date = QDate::fromString(dateText.trimmed(), Qt::ISODate);
+        if (date.isValid())
+        {
+            dateTime = date.startOfDay();
+        }
+    }
+
+    return dateTime;
+}
+
+bool GeospatialTimeWindows::isRange() const
+{
+    return start.isValid() && end.isValid();
+}
+
+bool GeospatialTimeWindows::isSliced() const
+{
+    return isRange() && 1 < windowCount;
+}
+
+QList<GeospatialTimeWindow> GeospatialTimeWindows::windows() const
+{
+    QList<GeospatialTimeWindow> timeWindows;
+    if (!isRange())
+    {
+        timeWindows.append(GeospatialTimeWindow(start, start));
+        return timeWindows;
+    }
+
+    // Equally sized windows, the last one ends exactly at the end of the range
+    int count = qBound(1, windowCount, MaximumWindowCount);
+    qint64 windowDuration = start.msecsTo(end) / count;
+    for (int windowIndex = 0; windowIndex < count; windowIndex++)
+    {
+        QDateTime windowStart = start.addMSecs(windowIndex * windowDuration);
+        QDateTime windowEnd = (count - 1 == windowIndex) ? end : start.addMSecs((windowIndex + 1) * windowDuration);
+        timeWindows.append(GeospatialTimeWindow(windowStart, windowEnd));
+    }
+
+    return timeWindows;
+}
+
+QMap<QString, GeoprocessingParameter*> GeospatialTimeWindows::createParameters(GeospatialTimeWindow const &window, QObject *parent) const
+{
+    QMap<QString, GeoprocessingParameter*> parameters;
+    parameters.insert(parameterName, new GeoprocessingDate(window.first, parent));
+    if (isRange()
+            && !endParameterName.isEmpty())
+    {
+        parameters.insert(endParameterName, new GeoprocessingDate(window.second, parent));
+    }
+
+    return parameters;
+}
+
+GeospatialTimeWindows GeospatialTimeWindows::parse(QString const &valueText)
+{
+    GeospatialTimeWindows timeWindows;
+    QStringList rangeParts = valueText.split('/');
+    switch (rangeParts.size())
+    {
+    case 1:
+        timeWindows.start = parseDateTime(rangeParts[0]);
+        break;
+
+    case 2:
+        timeWindows.start = parseDateTime(rangeParts[0]);
+        timeWindows.end = parseDateTime(rangeParts[1]);
+        if (!timeWindows.isRange()
+                || timeWindows.end <= timeWindows.start)
+        {
+            qDebug() << "Invalid date range" << valueText;
+            return GeospatialTimeWindows();
+        }
+        break;
+
+    default:
+        qDebug() << "Invalid date" << valueText;
+        return GeospatialTimeWindows();
+    }
+
+    return timeWindows;
+}
+
+QString GeospatialTimeWindows::windowLabel(GeospatialTimeWindow const &window)
+{
+    // Labels of the windows sort the same way as the windows themselves
+    QString dateFormat("yyyy-MM-dd HH:mm");
+    return QString("%1 - %2").arg(window.first.toString(dateFormat), window.second.toString(dateFormat));
+}
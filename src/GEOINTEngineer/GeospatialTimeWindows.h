@@ -0,0 +1,71 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#ifndef GEOSPATIALTIMEWINDOWS_H
+#define GEOSPATIALTIMEWINDOWS_H
+
+class QObject;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class GeoprocessingParameter;
+}
+}
+
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QString>
+
+typedef QPair<QDateTime, QDateTime> GeospatialTimeWindow;
+
+// Value of a date parameter, a single date or a range split into windows
+struct GeospatialTimeWindows
+{
+    QString parameterName;
+    // Receives the end of every window, the task only gets the window start without it
+    QString endParameterName;
+    QDateTime start;
+    QDateTime end;
+    int windowCount = 1;
+
+    bool isRange() const;
+    bool isSliced() const;
+    QList<GeospatialTimeWindow> windows() const;
+    QMap<QString, Esri::ArcGISRuntime::GeoprocessingParameter*> createParameters(GeospatialTimeWindow const &window, QObject *parent) const;
+
+    // "2024-01-01" or the range "2024-01-01/2024-03-31"
+    static GeospatialTimeWindows parse(QString const &valueText);
+    static QString windowLabel(GeospatialTimeWindow const &window);
+
+    const static int MaximumWindowCount = 64;
+
+private:
+    static QDateTime parseDateTime(QString const &dateText);
+};
+
+#endif // GEOSPATIALTIMEWINDOWS_H
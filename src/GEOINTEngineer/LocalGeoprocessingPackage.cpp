@@ -0,0 +1,394 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalGeoprocessingPackage.h"
+#include "LocalServiceScheduler.h"
+
+#include "LocalGeoprocessingService.h"
+#include "LocalServerTypes.h"
+
+#include <QDebug>
+
+using namespace Esri::ArcGISRuntime;
+
+LocalGeoprocessingPackage::LocalGeoprocessingPackage(QString const &packageFilePath, LocalServiceScheduler *serviceScheduler, QObject *parent) :
+    QObject(parent),
+    m_packageFilePath(packageFilePath),
+    m_serviceScheduler(serviceScheduler)
+{
+    m_idleTimer.setSingleShot(true);
+    connect(&m_idleTimer, &QTimer::timeout, this, &LocalGeoprocessingPackage::serviceIdle);
+}
+
+QString LocalGeoprocessingPackage::packageFilePath() const
+{
+    return m_packageFilePath;
+}
+
+LocalGeoprocessingService* LocalGeoprocessingPackage::service() const
+{
+    return m_geoprocessingService;
+}
+
+bool LocalGeoprocessingPackage::isStarted() const
+{
+    return nullptr != m_geoprocessingService
+            && LocalServerStatus::Started == m_geoprocessingService->status();
+}
+
+bool LocalGeoprocessingPackage::isStarting() const
+{
+    return nullptr != m_geoprocessingService
+            && LocalServerStatus::Starting == m_geoprocessingService->status();
+}
+
+void LocalGeoprocessingPackage::start()
+{
+    if (nullptr != m_geoprocessingService)
+    {
+        switch (m_geoprocessingService->status())
+        {
+        case LocalServerStatus::Starting:
+        case LocalServerStatus::Started:
+            return;
+
+        default:
+            // A stopped or failed service is replaced by a new one
+            m_geoprocessingService->deleteLater();
+            m_geoprocessingService = nullptr;
+            break;
+        }
+    }
+
+    LocalGeoprocessingService *localGpService = createService();
+    connect(localGpService, &LocalGeoprocessingService::statusChanged, this, [this, localGpService]()
+    {
+        switch (localGpService->status())
+        {
+        case LocalServerStatus::Starting:
+            qDebug() << "Local geospatial service " << localGpService->name() << " starting...";
+            break;
+
+        case LocalServerStatus::Started:
+            qDebug() << "Local geospatial service " << localGpService->name() << " started.";
+            qDebug() << localGpService->url();
+            if (m_restartPending)
+            {
+                // The package was replaced while the service was starting
+                localGpService->stop();
+                break;
+            }
+            touch();
+            emit serviceStarted(localGpService);
+            break;
+
+        case LocalServerStatus::Stopping:
+            qDebug() << "Local geospatial service " << localGpService->name() << " stopping...";
+            break;
+
+        case LocalServerStatus::Stopped:
+            qDebug() << "Local geospatial service " << localGpService->name() << " stopped.";
+            m_idleTimer.stop();
+            emit serviceStopped();
+            if (m_restartPending)
+            {
+                m_restartPending = false;
+                start();
+            }
+            break;
+
+        case LocalServerStatus::Failed:
+            qDebug() << "Local geospatial service " << localGpService->name() << " failed!";
+            m_idleTimer.stop();
+            emit serviceFailed();
+            break;
+        }
+
+    });
+    m_geoprocessingService = localGpService;
+
+    // Limit the number of services starting at the same time
+    m_serviceScheduler->schedule(m_packageFilePath, localGpService);
+}
+
+LocalGeoprocessingService* LocalGeoprocessingPackage::createService()
+{
+    // Create a new local geoprocessing service with map server results
+    // services of tiled tasks return their output features instead
+    LocalGeoprocessingService *localGpService = new LocalGeoprocessingService(m_packageFilePath, this);
+    GeoprocessingServiceType asynchronousServiceType = m_mapServerResult
+            ? GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult
+            : GeoprocessingServiceType::AsynchronousSubmit;
+    // TODO: When is map server result supported?
+    if (m_packageFilePath.endsWith(".gpk"))
+    {
+        localGpService->setServiceType(asynchronousServiceType);
+    }
+    else
+    {
+        //localGpService->setServiceType(GeoprocessingServiceType::SynchronousExecute);
+        localGpService->setServiceType(asynchronousServiceType);
+    }
+    return localGpService;
+}
+
+bool LocalGeoprocessingPackage::hasMapServerResult() const
+{
+    return m_mapServerResult;
+}
+
+void LocalGeoprocessingPackage::setMapServerResult(bool mapServerResult)
+{
+    m_mapServerResult = mapServerResult;
+}
+
+void LocalGeoprocessingPackage::stop()
+{
+    if (!isStarted())
+    {
+        return;
+    }
+
+    m_idleTimer.stop();
+    stopAdditionalServices();
+    m_geoprocessingService->stop();
+}
+
+int LocalGeoprocessingPackage::instanceCount() const
+{
+    return ((nullptr != m_geoprocessingService) ? 1 : 0) + m_additionalServices.size();
+}
+
+bool LocalGeoprocessingPackage::isInstanceStarting() const
+{
+    if (isStarting())
+    {
+        return true;
+    }
+
+    foreach (LocalGeoprocessingService const *additionalService, m_additionalServices)
+    {
+        if (LocalServerStatus::Starting == additionalService->status())
+        {
+            return true;
+        }
+    }
+
+    return nullptr != m_synchronousService
+            && LocalServerStatus::Starting == m_synchronousService->status();
+}
+
+QList<LocalGeoprocessingService*> LocalGeoprocessingPackage::additionalServices() const
+{
+    return m_additionalServices;
+}
+
+void LocalGeoprocessingPackage::addInstance()
+{
+    // Additional instances serve the same package next to a running service
+    if (!isStarted())
+    {
+        return;
+    }
+
+    LocalGeoprocessingService *localGpService = createService();
+    connect(localGpService, &LocalGeoprocessingService::statusChanged, this, [this, localGpService]()
+    {
+        switch (localGpService->status())
+        {
+        case LocalServerStatus::Started:
+            qDebug() << "Additional local geospatial service " << localGpService->name() << " started.";
+            if (m_retiredServices.contains(localGpService))
+            {
+                // The instance was removed while it was starting
+                localGpService->stop();
+                break;
+            }
+            touch();
+            emit serviceStarted(localGpService);
+            break;
+
+        case LocalServerStatus::Stopped:
+        case LocalServerStatus::Failed:
+            qDebug() << "Additional local geospatial service " << localGpService->name() << " stopped.";
+            m_additionalServices.removeOne(localGpService);
+            m_retiredServices.removeOne(localGpService);
+            emit instanceStopped(localGpService);
+            localGpService->deleteLater();
+            break;
+
+        default:
+            break;
+        }
+    });
+    m_additionalServices.append(localGpService);
+    m_serviceScheduler->schedule(m_packageFilePath, localGpService);
+}
+
+void LocalGeoprocessingPackage::removeInstance(LocalGeoprocessingService *geoprocessingService)
+{
+    if (!m_additionalServices.contains(geoprocessingService))
+    {
+        return;
+    }
+
+    retireService(geoprocessingService);
+}
+
+LocalGeoprocessingService* LocalGeoprocessingPackage::synchronousService() const
+{
+    return m_synchronousService;
+}
+
+void LocalGeoprocessingPackage::startSynchronousService()
+{
+    // Fast tasks skip the submit and poll overhead of the asynchronous service
+    if (!isStarted() || nullptr != m_synchronousService)
+    {
+        return;
+    }
+
+    LocalGeoprocessingService *localGpService = createService();
+    localGpService->setServiceType(GeoprocessingServiceType::SynchronousExecute);
+    connect(localGpService, &LocalGeoprocessingService::statusChanged, this, [this, localGpService]()
+    {
+        switch (localGpService->status())
+        {
+        case LocalServerStatus::Started:
+            qDebug() << "Synchronous local geospatial service " << localGpService->name() << " started.";
+            if (m_retiredServices.contains(localGpService))
+            {
+                // The package was restarted while the service was starting
+                localGpService->stop();
+                break;
+            }
+            emit serviceStarted(localGpService);
+            break;
+
+        case LocalServerStatus::Stopped:
+        case LocalServerStatus::Failed:
+            qDebug() << "Synchronous local geospatial service " << localGpService->name() << " stopped.";
+            m_synchronousService = nullptr;
+            m_retiredServices.removeOne(localGpService);
+            emit instanceStopped(localGpService);
+            localGpService->deleteLater();
+            break;
+
+        default:
+            break;
+        }
+    });
+    m_synchronousService = localGpService;
+    m_serviceScheduler->schedule(m_packageFilePath, localGpService);
+}
+
+void LocalGeoprocessingPackage::retireService(LocalGeoprocessingService *geoprocessingService)
+{
+    switch (geoprocessingService->status())
+    {
+    case LocalServerStatus::Started:
+        geoprocessingService->stop();
+        break;
+
+    case LocalServerStatus::Stopping:
+        break;
+
+    default:
+        // A queued or starting instance is stopped as soon as it has started
+        if (!m_retiredServices.contains(geoprocessingService))
+        {
+            m_retiredServices.append(geoprocessingService);
+        }
+        break;
+    }
+}
+
+void LocalGeoprocessingPackage::stopAdditionalServices()
+{
+    foreach (LocalGeoprocessingService *additionalService, m_additionalServices)
+    {
+        removeInstance(additionalService);
+    }
+
+    if (nullptr != m_synchronousService)
+    {
+        retireService(m_synchronousService);
+    }
+}
+
+void LocalGeoprocessingPackage::restart()
+{
+    if (nullptr == m_geoprocessingService)
+    {
+        start();
+        return;
+    }
+
+    // The pool grows again with the queued jobs
+    stopAdditionalServices();
+
+    switch (m_geoprocessingService->status())
+    {
+    case LocalServerStatus::Starting:
+        m_restartPending = true;
+        break;
+
+    case LocalServerStatus::Started:
+        m_restartPending = true;
+        stop();
+        break;
+
+    case LocalServerStatus::Stopping:
+        m_restartPending = true;
+        break;
+
+    default:
+        start();
+        break;
+    }
+}
+
+int LocalGeoprocessingPackage::idleTimeout() const
+{
+    return m_idleTimer.interval();
+}
+
+void LocalGeoprocessingPackage::setIdleTimeout(int idleTimeoutMilliseconds)
+{
+    m_idleTimer.setInterval(idleTimeoutMilliseconds);
+    if (0 >= idleTimeoutMilliseconds)
+    {
+        // A running timer would fire immediately
+        m_idleTimer.stop();
+    }
+}
+
+void LocalGeoprocessingPackage::touch()
+{
+    // No idle timeout means the service is never stopped
+    if (0 < m_idleTimer.interval() && isStarted())
+    {
+        m_idleTimer.start();
+    }
+}
@@ -0,0 +1,96 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef LOCALGEOPROCESSINGPACKAGE_H
+#define LOCALGEOPROCESSINGPACKAGE_H
+
+class LocalServiceScheduler;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class LocalGeoprocessingService;
+}
+}
+
+#include <QList>
+#include <QObject>
+#include <QTimer>
+
+class LocalGeoprocessingPackage : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LocalGeoprocessingPackage(QString const &packageFilePath, LocalServiceScheduler *serviceScheduler, QObject *parent = nullptr);
+
+    QString packageFilePath() const;
+    Esri::ArcGISRuntime::LocalGeoprocessingService* service() const;
+
+    bool isStarted() const;
+    bool isStarting() const;
+    void start();
+    void stop();
+    void restart();
+
+    int instanceCount() const;
+    bool isInstanceStarting() const;
+    QList<Esri::ArcGISRuntime::LocalGeoprocessingService*> additionalServices() const;
+    void addInstance();
+    void removeInstance(Esri::ArcGISRuntime::LocalGeoprocessingService *geoprocessingService);
+    Esri::ArcGISRuntime::LocalGeoprocessingService* synchronousService() const;
+    void startSynchronousService();
+
+    bool hasMapServerResult() const;
+    void setMapServerResult(bool mapServerResult);
+
+    int idleTimeout() const;
+    void setIdleTimeout(int idleTimeoutMilliseconds);
+    void touch();
+
+signals:
+    void serviceStarted(Esri::ArcGISRuntime::LocalGeoprocessingService *geoprocessingService);
+    void serviceStopped();
+    void serviceFailed();
+    void serviceIdle();
+    void instanceStopped(Esri::ArcGISRuntime::LocalGeoprocessingService *geoprocessingService);
+
+private:
+    Esri::ArcGISRuntime::LocalGeoprocessingService* createService();
+    void retireService(Esri::ArcGISRuntime::LocalGeoprocessingService *geoprocessingService);
+    void stopAdditionalServices();
+
+    QString m_packageFilePath;
+    LocalServiceScheduler *m_serviceScheduler;
+    Esri::ArcGISRuntime::LocalGeoprocessingService *m_geoprocessingService = nullptr;
+    QList<Esri::ArcGISRuntime::LocalGeoprocessingService*> m_additionalServices;
+    Esri::ArcGISRuntime::LocalGeoprocessingService *m_synchronousService = nullptr;
+    QList<Esri::ArcGISRuntime::LocalGeoprocessingService*> m_retiredServices;
+    QTimer m_idleTimer;
+    bool m_restartPending = false;
+    bool m_mapServerResult = true;
+};
+
+#endif // LOCALGEOPROCESSINGPACKAGE_H
@@ -23,25 +23,45 @@
 // See <https://developers.arcgis.com/qt/> for further information.
 //
 
+#include "GeospatialDatasetHandoff.h"
+#include "GeospatialInputUploads.h"
+#include "GeospatialJobScheduler.h"
+#include "GeospatialPipelineExecution.h"
+#include "GeospatialSweepExecution.h"
+#include "GeospatialTiledExecution.h"
+#include "GeospatialTimeSlicedExecution.h"
+#include "LocalGeoprocessingPackage.h"
 #include "LocalGeospatialServer.h"
 #include "LocalGeospatialTask.h"
+#include "LocalMapServiceGroup.h"
+#include "LocalServiceDaemonClient.h"
+#include "LocalServicePrewarmer.h"
+#include "LocalServiceScheduler.h"
+#include "LocalServiceWatchdog.h"
+#include "StartupTimeline.h"
 
 #include "ArcGISMapImageLayer.h"
 #include "ArcGISRuntimeEnvironment.h"
 #include "CoreTypes.h"
 #include "Credential.h"
+#include "FeatureCollection.h"
+#include "Geometry.h"
 #include "GeoprocessingFeatures.h"
+#include "GeoprocessingResult.h"
 #include "GeoprocessingTask.h"
+#include "GeoprocessingTypes.h"
+#include "GroupLayer.h"
+#include "Layer.h"
 #include "LicenseInfo.h"
 #include "LicenseResult.h"
 #include "LocalGeoprocessingService.h"
 #include "LocalMapService.h"
 #include "LocalServer.h"
 #include "MapTypes.h"
-#include "MobileMapPackage.h"
 #include "Portal.h"
 #include "TaskWatcher.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
@@ -51,14 +71,175 @@
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QProcessEnvironment>
+#include <QThread>
+#include <QtConcurrent>
+#include <QVector>
+
+#include <algorithm>
 
 using namespace Esri::ArcGISRuntime;
 
 LocalGeospatialServer::LocalGeospatialServer(QObject *parent) :
     QObject(parent),
-    m_networkAccessManager(new QNetworkAccessManager(this))
+    m_networkAccessManager(new QNetworkAccessManager(this)),
+    m_serviceScheduler(new LocalServiceScheduler(this)),
+    m_serviceWatchdog(new LocalServiceWatchdog(this)),
+    m_jobScheduler(new GeospatialJobScheduler(this)),
+    m_inputUploads(new GeospatialInputUploads(this)),
+    m_datasetHandoff(new GeospatialDatasetHandoff(this))
 {
     connect(m_networkAccessManager, &QNetworkAccessManager::finished, this, &LocalGeospatialServer::networkRequestFinished);
+    connect(&m_packageEnumerationWatcher, &QFutureWatcher<PackageEnumeration>::finished, this, &LocalGeospatialServer::packagesEnumerated);
+    connect(&m_licenseFileWatcher, &QFutureWatcher<QString>::finished, this, &LocalGeospatialServer::licenseFileValidated);
+
+    connect(m_jobScheduler, &GeospatialJobScheduler::jobReady, this, &LocalGeospatialServer::runTask);
+    connect(m_jobScheduler, &GeospatialJobScheduler::metricsChanged, this, &LocalGeospatialServer::growServicePools);
+
+    // Surplus service instances are stopped when the load stays low
+    m_servicePoolTimer.setInterval(60 * 1000);
+    connect(&m_servicePoolTimer, &QTimer::timeout, this, &LocalGeospatialServer::shrinkServicePools);
+
+    // Tasks of a failed service wait for the restarted one
+    connect(m_serviceWatchdog, &LocalServiceWatchdog::serviceUnhealthy, this, [this](LocalGeoprocessingPackage *geoprocessingPackage)
+    {
+        unbindTasks(geoprocessingPackage->packageFilePath());
+        emit servicesChanged();
+    });
+
+    // Copying a package raises many change notifications
+    m_packageReloadTimer.setSingleShot(true);
+    m_packageReloadTimer.setInterval(2000);
+    connect(&m_packageReloadTimer, &QTimer::timeout, this, &LocalGeospatialServer::reloadPackages);
+    connect(&m_packageWatcher, &QFileSystemWatcher::directoryChanged, &m_packageReloadTimer, qOverload<>(&QTimer::start));
+
+    // Lazy services are started when one of their tasks is executed
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString startModeKeyName = "geoint.service.startmode";
+    if (systemEnvironment.contains(startModeKeyName))
+    {
+        m_lazyStart = (0 == systemEnvironment.value(startModeKeyName).compare("lazy", Qt::CaseInsensitive));
+    }
+
+    // Idle services are stopped after the timeout in seconds, lazy services default to ten minutes
+    m_idleTimeout = m_lazyStart ? 10 * 60 * 1000 : 0;
+    QString idleTimeoutKeyName = "geoint.service.idletimeout";
+    if (systemEnvironment.contains(idleTimeoutKeyName))
+    {
+        m_idleTimeout = systemEnvironment.value(idleTimeoutKeyName).toInt() * 1000;
+    }
+
+    // Submit a synthetic job per started service
+    QString prewarmKeyName = "geoint.service.prewarm";
+    if (systemEnvironment.contains(prewarmKeyName)
+            && 0 == systemEnvironment.value(prewarmKeyName).compare("true", Qt::CaseInsensitive))
+    {
+        m_servicePrewarmer = new LocalServicePrewarmer(this);
+    }
+
+    // Datasets are served by a few shared map services using a blank template package
+    QString templateKeyName = "geoint.mapservice.template";
+    if (systemEnvironment.contains(templateKeyName))
+    {
+        m_mapServiceTemplateFilePath = systemEnvironment.value(templateKeyName);
+    }
+    QString processesKeyName = "geoint.mapservice.processes";
+    if (systemEnvironment.contains(processesKeyName))
+    {
+        m_mapServiceProcesses = qMax(1, systemEnvironment.value(processesKeyName).toInt());
+    }
+    QString maxLayersKeyName = "geoint.mapservice.maxlayers";
+    if (systemEnvironment.contains(maxLayersKeyName))
+    {
+        m_mapServiceMaxLayers = qMax(0, systemEnvironment.value(maxLayersKeyName).toInt());
+    }
+
+    // Heavy packages are served by up to this number of service instances
+    QString instancesKeyName = "geoint.service.instances";
+    if (systemEnvironment.contains(instancesKeyName))
+    {
+        m_maxServiceInstances = qMax(1, systemEnvironment.value(instancesKeyName).toInt());
+    }
+    if (1 < m_maxServiceInstances)
+    {
+        m_servicePoolTimer.start();
+    }
+
+    // Tasks faster than this number of milliseconds are executed by a synchronous service
+    QString synchronousThresholdKeyName = "geoint.jobs.syncthreshold";
+    if (systemEnvironment.contains(synchronousThresholdKeyName))
+    {
+        m_synchronousThreshold = qMax(0LL, systemEnvironment.value(synchronousThresholdKeyName).toLongLong());
+    }
+
+    // Jobs still running after this number of seconds are cancelled
+    QString jobDeadlineKeyName = "geoint.jobs.deadline";
+    if (systemEnvironment.contains(jobDeadlineKeyName))
+    {
+        m_jobDeadline = qMax(0, systemEnvironment.value(jobDeadlineKeyName).toInt()) * 1000;
+    }
+    if (nullptr != m_servicePrewarmer)
+    {
+        m_servicePrewarmer->setJobDeadline(m_jobDeadline);
+    }
+
+    // Chained tasks keep their intermediate results on the server
+    QString pipelinesKeyName = "geoint.pipelines";
+    if (systemEnvironment.contains(pipelinesKeyName))
+    {
+        m_pipelineDefinitions = GeospatialPipelineDefinition::load(systemEnvironment.value(pipelinesKeyName));
+    }
+
+    // Decomposable tasks split their area into one tile per core
+    QString tiledTasksKeyName = "geoint.tiling.tasks";
+    if (systemEnvironment.contains(tiledTasksKeyName))
+    {
+        m_tiledTaskNames = systemEnvironment.value(tiledTasksKeyName).split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    }
+    m_tileCount = QThread::idealThreadCount();
+    QString tileCountKeyName = "geoint.tiling.tiles";
+    if (systemEnvironment.contains(tileCountKeyName))
+    {
+        m_tileCount = qMax(1, systemEnvironment.value(tileCountKeyName).toInt());
+    }
+    QString tileOverlapKeyName = "geoint.tiling.overlap";
+    if (systemEnvironment.contains(tileOverlapKeyName))
+    {
+        m_tileOverlap = qMax(0.0, systemEnvironment.value(tileOverlapKeyName).toDouble() / 100.0);
+    }
+
+    // These tasks read their input features from a dataset written to the scratch directory
+    QString handoffTasksKeyName = "geoint.handoff.tasks";
+    if (systemEnvironment.contains(handoffTasksKeyName))
+    {
+        m_handoffTaskNames = systemEnvironment.value(handoffTasksKeyName).split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    }
+    QString handoffParameterKeyName = "geoint.handoff.parameter";
+    if (systemEnvironment.contains(handoffParameterKeyName))
+    {
+        m_handoffParameterName = systemEnvironment.value(handoffParameterKeyName);
+    }
+}
+
+LocalGeospatialServer* LocalGeospatialServer::instance()
+{
+    static LocalGeospatialServer *localGeospatialServer = new LocalGeospatialServer(QCoreApplication::instance());
+    return localGeospatialServer;
+}
+
+QList<LocalGeospatialTask*> LocalGeospatialServer::tasks() const
+{
+    return m_geospatialTasks;
+}
+
+QStringList LocalGeospatialServer::mobileMapPackageFilePaths() const
+{
+    QStringList packageFilePaths;
+    foreach (QFileInfo const &fileInfo, m_mobileMapPackageFiles)
+    {
+        packageFilePaths.append(fileInfo.absoluteFilePath());
+    }
+
+    return packageFilePaths;
 }
 
 QFileInfoList LocalGeospatialServer::listFiles(QString const &directoryPath, QString const &fileExtension) const
@@ -71,253 +252,1480 @@ QFileInfoList LocalGeospatialServer::listFiles(QString const &directoryPath, QSt
         return dataDirectory.entryInfoList();
     }
 
-    return QFileInfoList();
+    return QFileInfoList();
+}
+
+QFileInfoList LocalGeospatialServer::geoprocessingPackages() const
+{
+    QString pathKeyName = "geoint.modelpath";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(pathKeyName))
+    {
+        QString directoryPath = systemEnvironment.value(pathKeyName);
+        return listFiles(directoryPath, "*.gpkx");
+    }
+
+    return QFileInfoList();
+}
+
+QFileInfoList LocalGeospatialServer::mapPackages() const
+{
+    QString pathKeyName = "geoint.datapath";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(pathKeyName))
+    {
+        QString directoryPath = systemEnvironment.value(pathKeyName);
+        return listFiles(directoryPath, "*.mpkx");
+    }
+
+    return QFileInfoList();
+}
+
+QFileInfoList LocalGeospatialServer::mobileMapPackages() const
+{
+    QString pathKeyName = "geoint.datapath";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(pathKeyName))
+    {
+        QString directoryPath = systemEnvironment.value(pathKeyName);
+        return listFiles(directoryPath, "*.mmpk");
+    }
+
+    return QFileInfoList();
+}
+
+QFileInfoList LocalGeospatialServer::datasets() const
+{
+    QString pathKeyName = "geoint.datapath";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (m_mapServiceTemplateFilePath.isEmpty() || !systemEnvironment.contains(pathKeyName))
+    {
+        return QFileInfoList();
+    }
+
+    QString directoryPath = systemEnvironment.value(pathKeyName);
+    QFileInfoList datasetFiles;
+    foreach (QString const &fileExtension, QStringList() << "*.shp" << "*.tif" << "*.tiff" << "*.img")
+    {
+        datasetFiles.append(listFiles(directoryPath, fileExtension));
+    }
+
+    return datasetFiles;
+}
+
+QString LocalGeospatialServer::licenseFilePath() const
+{
+    return QDir::temp().filePath("geoint-engineer-license.lic");
+}
+
+LocalGeospatialServer::PackageEnumeration LocalGeospatialServer::enumeratePackages() const
+{
+    // Runs on a worker thread while the license is validated
+    PackageEnumeration packageEnumeration;
+    StartupTimeline::instance()->begin("packages.enumerate");
+    packageEnumeration.geoprocessingPackages = geoprocessingPackages();
+    packageEnumeration.mapPackages = mapPackages();
+    packageEnumeration.mobileMapPackages = mobileMapPackages();
+    packageEnumeration.datasets = datasets();
+    StartupTimeline::instance()->end("packages.enumerate");
+
+    StartupTimeline::instance()->begin("catalog.parse");
+    packageEnumeration.taskCatalog.load();
+    foreach (QFileInfo const &fileInfo, packageEnumeration.geoprocessingPackages)
+    {
+        QList<GeospatialTaskInfo> cachedTaskInfos = packageEnumeration.taskCatalog.tasks(fileInfo);
+        if (!cachedTaskInfos.isEmpty())
+        {
+            packageEnumeration.cachedTaskInfos.insert(fileInfo.absoluteFilePath(), cachedTaskInfos);
+        }
+    }
+    StartupTimeline::instance()->end("catalog.parse");
+    return packageEnumeration;
+}
+
+void LocalGeospatialServer::packagesEnumerated()
+{
+    PackageEnumeration packageEnumeration = m_packageEnumerationWatcher.result();
+    m_geoprocessingPackageFiles = packageEnumeration.geoprocessingPackages;
+    m_mapPackageFiles = packageEnumeration.mapPackages;
+    m_mobileMapPackageFiles = packageEnumeration.mobileMapPackages;
+    m_datasetFiles = packageEnumeration.datasets;
+    m_taskCatalog = packageEnumeration.taskCatalog;
+    m_packagesEnumerated = true;
+
+    // Offer the cached tasks while the services are starting
+    for (auto cachedIterator = packageEnumeration.cachedTaskInfos.constBegin(); cachedIterator != packageEnumeration.cachedTaskInfos.constEnd(); ++cachedIterator)
+    {
+        foreach (GeospatialTaskInfo const &taskInfo, cachedIterator.value())
+        {
+            qDebug() << "Cached task" << taskInfo.name << "of" << cachedIterator.key() << "added.";
+            registerTask(new LocalGeospatialTask(cachedIterator.key(), taskInfo, this));
+        }
+    }
+
+    // Mobile map packages are only opened when a map is selected
+    foreach (QFileInfo const &fileInfo, m_mobileMapPackageFiles)
+    {
+        emit mobileMapPackageAdded(fileInfo.absoluteFilePath());
+    }
+
+    watchPackageDirectories();
+    startServicesWhenReady();
+}
+
+QStringList LocalGeospatialServer::packageDirectories() const
+{
+    QStringList directoryPaths;
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    foreach (QString const &pathKeyName, QStringList() << "geoint.modelpath" << "geoint.datapath")
+    {
+        if (systemEnvironment.contains(pathKeyName))
+        {
+            QString directoryPath = systemEnvironment.value(pathKeyName);
+            if (QDir(directoryPath).exists() && !directoryPaths.contains(directoryPath))
+            {
+                directoryPaths.append(directoryPath);
+            }
+        }
+    }
+
+    return directoryPaths;
+}
+
+void LocalGeospatialServer::watchPackageDirectories()
+{
+    QStringList directoryPaths = packageDirectories();
+    if (!directoryPaths.isEmpty())
+    {
+        m_packageWatcher.addPaths(directoryPaths);
+    }
+}
+
+bool LocalGeospatialServer::containsPackage(QFileInfoList const &files, QString const &packageFilePath)
+{
+    foreach (QFileInfo const &fileInfo, files)
+    {
+        if (packageFilePath == fileInfo.absoluteFilePath())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool LocalGeospatialServer::isPackageModified(QFileInfo const &fileInfo, QFileInfoList const &knownFiles)
+{
+    foreach (QFileInfo const &knownFileInfo, knownFiles)
+    {
+        if (fileInfo.absoluteFilePath() == knownFileInfo.absoluteFilePath())
+        {
+            return fileInfo.size() != knownFileInfo.size()
+                    || fileInfo.lastModified() != knownFileInfo.lastModified();
+        }
+    }
+
+    return false;
+}
+
+void LocalGeospatialServer::reloadPackages()
+{
+    QFileInfoList geoprocessingPackages = this->geoprocessingPackages();
+    QFileInfoList mapPackages = this->mapPackages();
+    QFileInfoList mobileMapPackages = this->mobileMapPackages();
+    QFileInfoList datasets = this->datasets();
+
+    // Removed packages
+    foreach (QFileInfo const &fileInfo, m_geoprocessingPackageFiles)
+    {
+        if (!containsPackage(geoprocessingPackages, fileInfo.absoluteFilePath()))
+        {
+            qDebug() << "Geoprocessing package" << fileInfo.absoluteFilePath() << "was removed.";
+            removeGeoprocessingPackage(fileInfo.absoluteFilePath());
+        }
+    }
+    foreach (QFileInfo const &fileInfo, m_mapPackageFiles)
+    {
+        if (!containsPackage(mapPackages, fileInfo.absoluteFilePath()))
+        {
+            qDebug() << "Map package" << fileInfo.absoluteFilePath() << "was removed.";
+            stopMapPackage(fileInfo.absoluteFilePath());
+        }
+    }
+    foreach (QFileInfo const &fileInfo, m_mobileMapPackageFiles)
+    {
+        if (!containsPackage(mobileMapPackages, fileInfo.absoluteFilePath()))
+        {
+            qDebug() << "Mobile map package" << fileInfo.absoluteFilePath() << "was removed.";
+            emit mobileMapPackageRemoved(fileInfo.absoluteFilePath());
+        }
+    }
+
+    // New and replaced packages, only the affected services are started again
+    foreach (QFileInfo const &fileInfo, geoprocessingPackages)
+    {
+        QString packageFilePath = fileInfo.absoluteFilePath();
+        if (!containsPackage(m_geoprocessingPackageFiles, packageFilePath))
+        {
+            qDebug() << "Geoprocessing package" << packageFilePath << "was added.";
+            if (m_servicesStarted)
+            {
+                geoprocessingPackage(packageFilePath)->start();
+            }
+        }
+        else if (isPackageModified(fileInfo, m_geoprocessingPackageFiles))
+        {
+            qDebug() << "Geoprocessing package" << packageFilePath << "was replaced.";
+            m_taskCatalog.remove(packageFilePath);
+            m_taskCatalog.save();
+            if (m_servicesStarted)
+            {
+                geoprocessingPackage(packageFilePath)->restart();
+            }
+        }
+    }
+    foreach (QFileInfo const &fileInfo, mapPackages)
+    {
+        QString packageFilePath = fileInfo.absoluteFilePath();
+        bool added = !containsPackage(m_mapPackageFiles, packageFilePath);
+        bool replaced = !added && isPackageModified(fileInfo, m_mapPackageFiles);
+        if (replaced)
+        {
+            qDebug() << "Map package" << packageFilePath << "was replaced.";
+            stopMapPackage(packageFilePath);
+        }
+        if ((added || replaced) && m_servicesStarted)
+        {
+            startMapPackage(fileInfo);
+        }
+    }
+    foreach (QFileInfo const &fileInfo, mobileMapPackages)
+    {
+        if (!containsPackage(m_mobileMapPackageFiles, fileInfo.absoluteFilePath()))
+        {
+            qDebug() << "Mobile map package" << fileInfo.absoluteFilePath() << "was added.";
+            emit mobileMapPackageAdded(fileInfo.absoluteFilePath());
+        }
+    }
+
+    m_geoprocessingPackageFiles = geoprocessingPackages;
+    m_mapPackageFiles = mapPackages;
+    m_mobileMapPackageFiles = mobileMapPackages;
+
+    // Only the map service groups whose datasets changed are started again
+    bool datasetsChanged = datasets.size() != m_datasetFiles.size();
+    foreach (QFileInfo const &fileInfo, datasets)
+    {
+        datasetsChanged = datasetsChanged
+                || !containsPackage(m_datasetFiles, fileInfo.absoluteFilePath())
+                || isPackageModified(fileInfo, m_datasetFiles);
+    }
+    m_datasetFiles = datasets;
+    if (datasetsChanged && m_servicesStarted)
+    {
+        qDebug() << "Datasets were changed.";
+        startMapServiceGroups();
+    }
+
+    // Directories which were created after the startup
+    watchPackageDirectories();
+}
+
+void LocalGeospatialServer::removeGeoprocessingPackage(QString const &packageFilePath)
+{
+    m_serviceScheduler->cancel(packageFilePath);
+    m_pendingCatalogEntries.remove(packageFilePath);
+    m_taskCatalog.remove(packageFilePath);
+    m_taskCatalog.save();
+    removeTasks(packageFilePath, QStringList());
+
+    if (m_geoprocessingPackages.contains(packageFilePath))
+    {
+        LocalGeoprocessingPackage *geoprocessingPackage = m_geoprocessingPackages.take(packageFilePath);
+        m_pendingPackageStarts.removeAll(geoprocessingPackage);
+        m_serviceWatchdog->unwatch(geoprocessingPackage);
+        disconnect(geoprocessingPackage, nullptr, this, nullptr);
+        if (geoprocessingPackage->isStarted())
+        {
+            connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceStopped, geoprocessingPackage, &QObject::deleteLater);
+            geoprocessingPackage->stop();
+        }
+        else
+        {
+            geoprocessingPackage->deleteLater();
+        }
+    }
+}
+
+void LocalGeospatialServer::removeTasks(QString const &packageFilePath, QStringList const &keptTaskNames)
+{
+    for (int index = m_geospatialTasks.size() - 1; 0 <= index; index--)
+    {
+        LocalGeospatialTask *geospatialTask = m_geospatialTasks[index];
+        if (packageFilePath == geospatialTask->packageFilePath()
+                && !keptTaskNames.contains(geospatialTask->name()))
+        {
+            qDebug() << "Geospatial task" << geospatialTask->name() << "of" << packageFilePath << "removed.";
+            m_geospatialTasks.removeAt(index);
+            m_jobScheduler->removeTask(geospatialTask);
+            emit taskRemoved(geospatialTask);
+            geospatialTask->deleteLater();
+        }
+    }
+}
+
+void LocalGeospatialServer::startLocalServer()
+{
+    if (nullptr != m_daemonClient)
+    {
+        // Attach to the services of a running daemon instead
+        StartupTimeline::instance()->begin("daemon.attach");
+        m_daemonClient->attach();
+        return;
+    }
+
+    StartupTimeline::instance()->begin("localserver.start");
+    connect(LocalServer::instance(), &LocalServer::statusChanged, this, &LocalGeospatialServer::statusChanged, Qt::UniqueConnection);
+    LocalServer::start();
+}
+
+void LocalGeospatialServer::daemonAttached()
+{
+    StartupTimeline::instance()->end("daemon.attach");
+    m_status = Status::Started;
+}
+
+void LocalGeospatialServer::daemonAttachFailed()
+{
+    // Fall back to an own local server
+    StartupTimeline::instance()->end("daemon.attach");
+    m_daemonClient->deleteLater();
+    m_daemonClient = nullptr;
+    if (!LocalServer::instance()->isInstallValid())
+    {
+        m_status = Status::Failed;
+        return;
+    }
+
+    startLocalServer();
+}
+
+void LocalGeospatialServer::daemonDetached()
+{
+    // Services of the daemon are gone, the tasks wait for the next attach
+    foreach (QString const &packageFilePath, m_attachedServiceUrls.keys())
+    {
+        unbindTasks(packageFilePath);
+    }
+    m_attachedServiceUrls.clear();
+    attachServices(QJsonArray());
+
+    StartupTimeline::instance()->begin("daemon.attach");
+    m_daemonClient->attach();
+}
+
+void LocalGeospatialServer::attachServices(QJsonArray const &services)
+{
+    QMap<QString, QJsonObject> geoprocessingServices;
+    QMap<QString, QJsonObject> mapServices;
+    foreach (QJsonValue const &serviceValue, services)
+    {
+        QJsonObject serviceObject = serviceValue.toObject();
+        if ("geoprocessing" == serviceObject["kind"].toString())
+        {
+            geoprocessingServices.insert(serviceObject["package"].toString(), serviceObject);
+        }
+        else
+        {
+            mapServices.insert(serviceObject["package"].toString(), serviceObject);
+        }
+    }
+
+    // Stopped or restarted geoprocessing services
+    foreach (QString const &packageFilePath, m_attachedServiceUrls.keys())
+    {
+        QUrl serviceUrl = QUrl(geoprocessingServices.value(packageFilePath)["url"].toString());
+        if (serviceUrl != m_attachedServiceUrls[packageFilePath])
+        {
+            unbindTasks(packageFilePath);
+            m_attachedServiceUrls.remove(packageFilePath);
+        }
+    }
+    for (auto serviceIterator = geoprocessingServices.constBegin(); serviceIterator != geoprocessingServices.constEnd(); ++serviceIterator)
+    {
+        QString packageFilePath = serviceIterator.key();
+        if (!m_attachedServiceUrls.contains(packageFilePath))
+        {
+            QUrl serviceUrl = QUrl(serviceIterator.value()["url"].toString());
+            qDebug() << "Attached geoprocessing service" << serviceUrl << "of" << packageFilePath;
+            m_attachedServiceUrls.insert(packageFilePath, serviceUrl);
+            addGeoprocessingTasks(packageFilePath, serviceUrl, static_cast<GeoprocessingServiceType>(serviceIterator.value()["serviceType"].toInt()));
+        }
+    }
+
+    // Stopped or restarted map services
+    foreach (QString const &packageFilePath, m_mapServiceLayers.keys())
+    {
+        QUrl serviceUrl = QUrl(mapServices.value(packageFilePath)["url"].toString());
+        if (serviceUrl != m_mapServiceLayers[packageFilePath]->url())
+        {
+            ArcGISMapImageLayer *mapImageLayer = m_mapServiceLayers.take(packageFilePath);
+            emit mapServiceRemoved(mapImageLayer);
+            mapImageLayer->deleteLater();
+        }
+    }
+    for (auto serviceIterator = mapServices.constBegin(); serviceIterator != mapServices.constEnd(); ++serviceIterator)
+    {
+        QString packageFilePath = serviceIterator.key();
+        if (m_mapServiceLayers.contains(packageFilePath))
+        {
+            continue;
+        }
+
+        QJsonArray sublayerInfos = serviceIterator.value()["sublayers"].toArray();
+        ArcGISMapImageLayer *mapImageLayer = new ArcGISMapImageLayer(QUrl(serviceIterator.value()["url"].toString()), this);
+        m_mapServiceLayers.insert(packageFilePath, mapImageLayer);
+        connect(mapImageLayer, &ArcGISMapImageLayer::loadStatusChanged, this, [this, mapImageLayer, sublayerInfos](LoadStatus loadStatus)
+        {
+            if (LoadStatus::Loaded == loadStatus)
+            {
+                qDebug() << "Attached map service " << mapImageLayer->url() << " loaded.";
+                LocalMapServiceGroup::addSublayers(mapImageLayer, sublayerInfos);
+                emit mapServiceLoaded(mapImageLayer);
+            }
+        });
+        mapImageLayer->load();
+    }
+}
+
+QJsonArray LocalGeospatialServer::serviceDirectory() const
+{
+    QJsonArray services;
+    foreach (LocalGeoprocessingPackage const *geoprocessingPackage, m_geoprocessingPackages)
+    {
+        if (geoprocessingPackage->isStarted())
+        {
+            QJsonObject serviceObject;
+            serviceObject.insert("kind", "geoprocessing");
+            serviceObject.insert("package", geoprocessingPackage->packageFilePath());
+            serviceObject.insert("url", geoprocessingPackage->service()->url().toString());
+            serviceObject.insert("serviceType", static_cast<int>(geoprocessingPackage->service()->serviceType()));
+            services.append(serviceObject);
+        }
+    }
+
+    for (auto layerIterator = m_mapServiceLayers.constBegin(); layerIterator != m_mapServiceLayers.constEnd(); ++layerIterator)
+    {
+        QJsonObject serviceObject;
+        serviceObject.insert("kind", "map");
+        serviceObject.insert("package", layerIterator.key());
+        serviceObject.insert("url", layerIterator.value()->url().toString());
+        services.append(serviceObject);
+    }
+
+    foreach (LocalMapServiceGroup const *mapServiceGroup, m_mapServiceGroups)
+    {
+        if (nullptr != mapServiceGroup->mapImageLayer())
+        {
+            QJsonObject serviceObject;
+            serviceObject.insert("kind", "map");
+            serviceObject.insert("package", mapServiceGroup->mapImageLayer()->url().toString());
+            serviceObject.insert("url", mapServiceGroup->mapImageLayer()->url().toString());
+            serviceObject.insert("sublayers", mapServiceGroup->sublayerInfos());
+            services.append(serviceObject);
+        }
+    }
+
+    return services;
+}
+
+void LocalGeospatialServer::startServicesWhenReady()
+{
+    // Both the local server and the package enumeration are required
+    if (!m_localServerStarted || !m_packagesEnumerated || m_servicesStarted)
+    {
+        return;
+    }
+
+    m_servicesStarted = true;
+    m_status = Status::Started;
+    StartupTimeline::instance()->begin("services.schedule");
+    startGeoprocessing();
+    startMapping();
+    StartupTimeline::instance()->end("services.schedule");
+}
+
+LocalGeospatialServer::Status LocalGeospatialServer::start()
+{
+    if (Status::Stopped != m_status)
+    {
+        return m_status;
+    }
+
+    // Clients attach to the services of a shared daemon, the daemon itself owns the local server
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString daemonKeyName = "geoint.daemon";
+    if (systemEnvironment.contains(daemonKeyName)
+            && 0 == systemEnvironment.value(daemonKeyName).compare("true", Qt::CaseInsensitive)
+            && !QCoreApplication::arguments().contains("--daemon"))
+    {
+        m_daemonClient = new LocalServiceDaemonClient(this);
+        connect(m_daemonClient, &LocalServiceDaemonClient::attached, this, &LocalGeospatialServer::daemonAttached);
+        connect(m_daemonClient, &LocalServiceDaemonClient::attachFailed, this, &LocalGeospatialServer::daemonAttachFailed);
+        connect(m_daemonClient, &LocalServiceDaemonClient::detached, this, &LocalGeospatialServer::daemonDetached);
+        connect(m_daemonClient, &LocalServiceDaemonClient::servicesPublished, this, &LocalGeospatialServer::attachServices);
+    }
+    else if (!LocalServer::instance()->isInstallValid())
+    {
+        m_status = Status::Failed;
+        return m_status;
+    }
+
+    m_status = Status::Starting;
+
+    // Enumerate the packages and parse the task catalog while the license is validated
+    m_packageEnumerationWatcher.setFuture(QtConcurrent::run([this]()
+    {
+        return enumeratePackages();
+    }));
+
+    // The license file is validated while the QML engine is loaded
+    StartupTimeline::instance()->begin("license");
+    m_licenseFileWatcher.setFuture(QtConcurrent::run([this]()
+    {
+        return readLicenseFile();
+    }));
+
+    return m_status;
+}
+
+QUuid LocalGeospatialServer::executeTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext)
+{
+    if (!geospatialTask->hasInputFeaturesParameter())
+    {
+        return QUuid();
+    }
+
+    submitTask(geospatialTask, taskContext, GeospatialJobScheduler::Priority::Interactive);
+    return taskContext.requestId;
+}
+
+QUuid LocalGeospatialServer::speculateTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext)
+{
+    if (!geospatialTask->hasInputFeaturesParameter())
+    {
+        return QUuid();
+    }
+
+    // Speculative executions only use otherwise idle capacity
+    submitTask(geospatialTask, taskContext, GeospatialJobScheduler::Priority::Background);
+    return taskContext.requestId;
+}
+
+QUuid LocalGeospatialServer::executeSweep(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialParameterSweep const &parameterSweep)
+{
+    if (!geospatialTask->hasInputFeaturesParameter())
+    {
+        return QUuid();
+    }
+
+    // The variants run as concurrent interactive jobs and are reported as one group
+    GeospatialSweepExecution *sweepExecution = new GeospatialSweepExecution(geospatialTask, taskContext, parameterSweep, this);
+    connect(sweepExecution, &GeospatialSweepExecution::variantReady, this, [this](LocalGeospatialTask *variantTask, GeospatialTaskContext const &variantContext)
+    {
+        submitTask(variantTask, variantContext, GeospatialJobScheduler::Priority::Interactive);
+    });
+    quint64 inputVersion = taskContext.inputVersion;
+    connect(sweepExecution, &GeospatialSweepExecution::executionCompleted, this, [this, sweepExecution, inputVersion](QUuid const &requestId, GroupLayer *groupLayer)
+    {
+        if (nullptr != groupLayer)
+        {
+            groupLayer->setParent(this);
+            if (0 != inputVersion
+                    && inputVersion < m_inputVersion)
+            {
+                qDebug() << "Sweep" << requestId << "dropped, the input was superseded.";
+                groupLayer->deleteLater();
+            }
+            else
+            {
+                emit sweepCompleted(requestId, groupLayer);
+            }
+        }
+        sweepExecution->deleteLater();
+    });
+    sweepExecution->start();
+    return taskContext.requestId;
+}
+
+QUuid LocalGeospatialServer::executeTimeSlices(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialTimeWindows const &timeWindows)
+{
+    if (!geospatialTask->hasInputFeaturesParameter())
+    {
+        return QUuid();
+    }
+
+    // The windows run as concurrent interactive jobs and every window is reported on its own
+    // they are cancelled together with their execution request
+    QUuid parentRequestId = taskContext.requestId;
+    m_childRequestIds.insert(parentRequestId, QList<QUuid>());
+    GeospatialTimeSlicedExecution *timeSlicedExecution = new GeospatialTimeSlicedExecution(geospatialTask, taskContext, timeWindows, this);
+    connect(timeSlicedExecution, &GeospatialTimeSlicedExecution::windowReady, this, [this, parentRequestId](LocalGeospatialTask *windowTask, GeospatialTaskContext const &windowContext)
+    {
+        if (!m_childRequestIds.contains(parentRequestId))
+        {
+            dropTask(windowContext);
+            return;
+        }
+
+        m_childRequestIds[parentRequestId].append(windowContext.requestId);
+        submitTask(windowTask, windowContext, GeospatialJobScheduler::Priority::Interactive);
+    });
+    quint64 inputVersion = taskContext.inputVersion;
+    connect(timeSlicedExecution, &GeospatialTimeSlicedExecution::windowCompleted, this, [this, inputVersion](QUuid const &requestId, GroupLayer *groupLayer, Layer *windowLayer)
+    {
+        if (0 != inputVersion
+                && inputVersion < m_inputVersion)
+        {
+            qDebug() << "Time window" << windowLayer->name() << "of" << requestId << "dropped, the input was superseded.";
+            windowLayer->deleteLater();
+            return;
+        }
+
+        emit timeWindowCompleted(requestId, groupLayer, windowLayer);
+    });
+    connect(timeSlicedExecution, &GeospatialTimeSlicedExecution::executionCompleted, this, [this, timeSlicedExecution](QUuid const &requestId)
+    {
+        m_childRequestIds.remove(requestId);
+        timeSlicedExecution->deleteLater();
+    });
+    timeSlicedExecution->start();
+    return taskContext.requestId;
+}
+
+void LocalGeospatialServer::submitTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &requestedContext, GeospatialJobScheduler::Priority priority)
+{
+    GeospatialTaskContext taskContext = requestedContext;
+    if (taskContext.deadline.isForever()
+            && 0 < m_jobDeadline)
+    {
+        taskContext.deadline.setRemainingTime(m_jobDeadline);
+    }
+    if (0 != taskContext.inputVersion)
+    {
+        m_requestInputVersions.insert(taskContext.requestId, taskContext.inputVersion);
+    }
+
+    // Large areas of decomposable tasks run as one job per tile
+    if (m_tiledTaskNames.contains(geospatialTask->name())
+            && 1 < m_tileCount
+            && !taskContext.inputGeometry.isEmpty()
+            && !taskContext.resultByReference
+            && GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult != geospatialTask->taskInfo().serviceType)
+    {
+        if (taskContext.resultSink)
+        {
+            m_resultSinks.insert(taskContext.requestId, taskContext.resultSink);
+        }
+
+        // The tiles are cancelled and prioritized together with their execution request
+        QUuid parentRequestId = taskContext.requestId;
+        m_childRequestIds.insert(parentRequestId, QList<QUuid>());
+        GeospatialTiledExecution *tiledExecution = new GeospatialTiledExecution(geospatialTask, taskContext, m_tileCount, m_tileOverlap, this);
+        connect(tiledExecution, &GeospatialTiledExecution::tileReady, this, [this, priority, parentRequestId](LocalGeospatialTask *tiledTask, GeospatialTaskContext const &tileContext)
+        {
+            if (!m_childRequestIds.contains(parentRequestId))
+            {
+                dropTask(tileContext);
+                return;
+            }
+
+            m_childRequestIds[parentRequestId].append(tileContext.requestId);
+            if (m_prioritizedRequestIds.contains(parentRequestId))
+            {
+                scheduleTask(tiledTask, tileContext, GeospatialJobScheduler::Priority::Interactive);
+                return;
+            }
+            scheduleTask(tiledTask, tileContext, priority);
+        });
+        connect(tiledExecution, &GeospatialTiledExecution::executionCompleted, this, [this, tiledExecution](QUuid const &requestId, FeatureCollection *mergedFeatures)
+        {
+            tiledExecution->deleteLater();
+            m_prioritizedRequestIds.remove(requestId);
+            if (!m_childRequestIds.contains(requestId))
+            {
+                qDebug() << "Merged tiles of execution request" << requestId << "dropped, the request was cancelled.";
+                mergedFeatures->deleteLater();
+                return;
+            }
+
+            m_childRequestIds.remove(requestId);
+            mergedFeatures->setParent(this);
+            completeTask(requestId, nullptr, nullptr, mergedFeatures);
+        });
+        tiledExecution->start();
+        return;
+    }
+
+    scheduleTask(geospatialTask, taskContext, priority);
+}
+
+void LocalGeospatialServer::scheduleTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialJobScheduler::Priority priority)
+{
+    if (taskContext.resultSink)
+    {
+        m_resultSinks.insert(taskContext.requestId, taskContext.resultSink);
+    }
+
+    // Tiles of a superseded input may still arrive
+    if (taskContext.isSupersededBy(m_inputVersion))
+    {
+        dropTask(taskContext);
+        return;
+    }
+
+    if (!completeFromCache(geospatialTask, taskContext))
+    {
+        m_jobScheduler->submit(geospatialTask, taskContext, priority);
+    }
+}
+
+void LocalGeospatialServer::dropTask(GeospatialTaskContext const &taskContext)
+{
+    // The execution reports an empty result like a cancelled job
+    if (taskContext.resultSink)
+    {
+        m_resultSinks.insert(taskContext.requestId, taskContext.resultSink);
+    }
+
+    QUuid requestId = taskContext.requestId;
+    QTimer::singleShot(0, this, [this, requestId]()
+    {
+        localJobFinished(requestId);
+    });
+}
+
+void LocalGeospatialServer::completeTask(QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+{
+    // Results of a superseded input are dropped
+    quint64 inputVersion = m_requestInputVersions.take(requestId);
+    if (0 != inputVersion
+            && inputVersion < m_inputVersion
+            && !m_resultSinks.contains(requestId))
+    {
+        qDebug() << "Result of execution request" << requestId << "dropped, the input was superseded.";
+        if (nullptr != mapImageLayerResult)
+        {
+            mapImageLayerResult->deleteLater();
+        }
+        if (nullptr != featureCollectionResult)
+        {
+            featureCollectionResult->deleteLater();
+        }
+        return;
+    }
+
+    // Executions with a result sink are not reported to everyone
+    if (m_resultSinks.contains(requestId))
+    {
+        GeospatialResultSink resultSink = m_resultSinks.take(requestId);
+        resultSink(requestId, result, mapImageLayerResult, featureCollectionResult);
+        return;
+    }
+
+    emit taskCompleted(requestId, result, mapImageLayerResult, featureCollectionResult);
+}
+
+bool LocalGeospatialServer::completeFromCache(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext)
+{
+    if (!m_resultCache.isEnabled()
+            || taskContext.resultByReference)
+    {
+        return false;
+    }
+
+    QByteArray resultKey = m_resultCache.key(geospatialTask, m_taskCatalog.contentHash(geospatialTask->packageFilePath()), taskContext);
+    if (resultKey.isEmpty())
+    {
+        return false;
+    }
+
+    // A map image result lives in the jobs directory of the service which created it
+    GeospatialResultCache::CachedResult cachedResult;
+    bool cachedResultAvailable = m_resultCache.lookup(resultKey, cachedResult);
+    if (cachedResultAvailable
+            && !cachedResult.mapImageLayerUrl.isEmpty())
+    {
+        cachedResultAvailable = false;
+        foreach (QUrl const &taskUrl, geospatialTask->urls())
+        {
+            QString serviceEndpoint = taskUrl.toString().section("/GPServer/", 0, 0);
+            if (cachedResult.mapImageLayerUrl.toString().startsWith(serviceEndpoint + "/MapServer/"))
+            {
+                cachedResultAvailable = true;
+                break;
+            }
+        }
+    }
+    if (!cachedResultAvailable)
+    {
+        m_resultKeys.insert(taskContext.requestId, resultKey);
+        return false;
+    }
+
+    qDebug() << "Execution request" << taskContext.requestId << "of" << geospatialTask->name() << "served from the result cache.";
+    QTimer::singleShot(0, this, [this, taskContext, cachedResult]()
+    {
+        ArcGISMapImageLayer *cachedMapImageLayer = nullptr;
+        if (!cachedResult.mapImageLayerUrl.isEmpty())
+        {
+            cachedMapImageLayer = new ArcGISMapImageLayer(cachedResult.mapImageLayerUrl, this);
+        }
+        // Features cached next to a map image result are not drawn
+        FeatureCollection *cachedFeatures = nullptr;
+        if (nullptr == cachedMapImageLayer
+                && !cachedResult.featureCollectionJson.isEmpty())
+        {
+            cachedFeatures = FeatureCollection::fromJson(cachedResult.featureCollectionJson, this);
+        }
+
+        completeTask(taskContext.requestId, nullptr, cachedMapImageLayer, cachedFeatures);
+    });
+    return true;
+}
+
+void LocalGeospatialServer::runTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext)
+{
+    // Queued jobs may pass their deadline before they are dispatched
+    if (taskContext.hasExpired())
+    {
+        qDebug() << "Execution request" << taskContext.requestId << "of" << geospatialTask->name() << "expired before it started.";
+        m_jobScheduler->finishJob(geospatialTask);
+        localJobFinished(taskContext.requestId);
+        return;
+    }
+
+    // The daemon owns the services of attached clients
+    if (nullptr != m_daemonClient)
+    {
+        m_daemonClient->useGeoprocessingPackage(geospatialTask->packageFilePath());
+    }
+    else
+    {
+        useGeoprocessingPackage(geospatialTask->packageFilePath());
+    }
+
+    geospatialTask->executeTask(taskContext);
+}
+
+void LocalGeospatialServer::useGeoprocessingPackage(QString const &packageFilePath)
+{
+    m_serviceScheduler->recordPackageUsage(packageFilePath);
+
+    LocalGeoprocessingPackage *geoprocessingPackage = this->geoprocessingPackage(packageFilePath);
+    if (geoprocessingPackage->isStarted())
+    {
+        m_warmHitCount++;
+        geoprocessingPackage->touch();
+    }
+    else
+    {
+        if (!geoprocessingPackage->isStarting()
+                && !m_pendingPackageStarts.contains(geoprocessingPackage))
+        {
+            m_coldStartCount++;
+        }
+        startGeoprocessingPackage(geoprocessingPackage);
+    }
+    qDebug() << "Service cold starts:" << m_coldStartCount << "warm hits:" << m_warmHitCount;
+}
+
+bool LocalGeospatialServer::useSharedGeoprocessingPackage(QString const &packageFilePath)
+{
+    // Clients of the daemon may only start the packages it enumerated itself
+    if (!containsPackage(m_geoprocessingPackageFiles, packageFilePath))
+    {
+        qDebug() << "Unknown geoprocessing package" << packageFilePath << "rejected.";
+        return false;
+    }
+
+    // The jobs of the clients are not seen by the idle timeout, a shared service keeps running
+    geoprocessingPackage(packageFilePath)->setIdleTimeout(0);
+    useGeoprocessingPackage(packageFilePath);
+    return true;
+}
+
+void LocalGeospatialServer::executeTasks(GeoprocessingFeatures *inputFeatures, Geometry const &inputGeometry, quint64 inputVersion)
+{
+    // Batch jobs never delay an interactive execution
+    foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+    {
+        if (geospatialTask->hasInputFeaturesParameter())
+        {
+            submitTask(geospatialTask, GeospatialTaskContext::create(inputFeatures, inputGeometry, inputVersion), GeospatialJobScheduler::Priority::Batch);
+        }
+    }
+}
+
+QStringList LocalGeospatialServer::pipelineNames() const
+{
+    QStringList pipelineNames;
+    foreach (GeospatialPipelineDefinition const &pipelineDefinition, m_pipelineDefinitions)
+    {
+        pipelineNames.append(pipelineDefinition.name);
+    }
+
+    return pipelineNames;
+}
+
+QUuid LocalGeospatialServer::executePipeline(QString const &pipelineName, GeospatialTaskContext const &pipelineContext)
+{
+    foreach (GeospatialPipelineDefinition const &pipelineDefinition, m_pipelineDefinitions)
+    {
+        if (pipelineName != pipelineDefinition.name)
+        {
+            continue;
+        }
+
+        // Steps refer to their tasks by name
+        QMap<QString, LocalGeospatialTask*> stepTasks;
+        foreach (GeospatialPipelineStep const &step, pipelineDefinition.steps)
+        {
+            foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+            {
+                if (step.taskName == geospatialTask->name())
+                {
+                    stepTasks.insert(step.id, geospatialTask);
+                    break;
+                }
+            }
+        }
+
+        // Only the final outputs of the pipeline are reported
+        // the running steps are cancelled together with the execution request
+        QUuid parentRequestId = pipelineContext.requestId;
+        m_childRequestIds.insert(parentRequestId, QList<QUuid>());
+        GeospatialPipelineExecution *pipelineExecution = new GeospatialPipelineExecution(pipelineDefinition, stepTasks, pipelineContext, this);
+        connect(pipelineExecution, &GeospatialPipelineExecution::stepReady, this, [this, parentRequestId](LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &stepContext)
+        {
+            if (!m_childRequestIds.contains(parentRequestId))
+            {
+                dropTask(stepContext);
+                return;
+            }
+
+            m_childRequestIds[parentRequestId].append(stepContext.requestId);
+            submitTask(geospatialTask, stepContext, GeospatialJobScheduler::Priority::Interactive);
+        });
+        quint64 inputVersion = pipelineContext.inputVersion;
+        connect(pipelineExecution, &GeospatialPipelineExecution::outputCompleted, this, [this, parentRequestId, inputVersion](QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult, FeatureCollection *featureCollectionResult)
+        {
+            bool superseded = 0 != inputVersion
+                    && inputVersion < m_inputVersion;
+            if (superseded
+                    || !m_childRequestIds.contains(parentRequestId))
+            {
+                qDebug() << "Pipeline output" << requestId << "dropped," << (superseded ? "the input was superseded." : "the pipeline was cancelled.");
+                if (nullptr != mapImageLayerResult)
+                {
+                    mapImageLayerResult->deleteLater();
+                }
+                if (nullptr != featureCollectionResult)
+                {
+                    featureCollectionResult->deleteLater();
+                }
+                return;
+            }
+
+            emit taskCompleted(requestId, result, mapImageLayerResult, featureCollectionResult);
+        });
+        connect(pipelineExecution, &GeospatialPipelineExecution::executionCompleted, this, [this, pipelineExecution](QUuid const &requestId)
+        {
+            m_childRequestIds.remove(requestId);
+            pipelineExecution->deleteLater();
+        });
+        pipelineExecution->start();
+        return pipelineContext.requestId;
+    }
+
+    qDebug() << "Unknown pipeline" << pipelineName;
+    return QUuid();
+}
+
+quint64 LocalGeospatialServer::supersedeInputs()
+{
+    // Executions of the previous inputs are cancelled and their results are dropped
+    quint64 inputVersion = ++m_inputVersion;
+    cancelTasks([inputVersion](GeospatialTaskContext const &taskContext)
+    {
+        return taskContext.isSupersededBy(inputVersion);
+    });
+    m_inputUploads->releaseUploads(inputVersion);
+
+    return m_inputVersion;
+}
+
+void LocalGeospatialServer::cancelTask(QUuid const &requestId)
+{
+    // The jobs the execution request was split into are cancelled as well
+    // time windows may be split into tiles again
+    QList<QUuid> requestIds;
+    requestIds.append(requestId);
+    QList<QUuid> splitRequestIds;
+    for (int requestIndex = 0; requestIndex < requestIds.size(); requestIndex++)
+    {
+        QUuid const cancelledRequestId = requestIds[requestIndex];
+        if (m_childRequestIds.contains(cancelledRequestId))
+        {
+            requestIds.append(m_childRequestIds.take(cancelledRequestId));
+            splitRequestIds.append(cancelledRequestId);
+        }
+        m_prioritizedRequestIds.remove(cancelledRequestId);
+    }
+    cancelTasks([requestIds](GeospatialTaskContext const &taskContext)
+    {
+        return requestIds.contains(taskContext.requestId);
+    });
+
+    // A split execution request has no job of its own and ends right now
+    localJobFinished(requestId);
+    foreach (QUuid const &splitRequestId, splitRequestIds)
+    {
+        if (requestId != splitRequestId)
+        {
+            localJobFinished(splitRequestId);
+        }
+    }
+}
+
+void LocalGeospatialServer::cancelTasks(GeospatialTaskFilter const &taskFilter)
+{
+    foreach (GeospatialTaskContext const &cancelledContext, m_jobScheduler->removeJobs(taskFilter))
+    {
+        localJobFinished(cancelledContext.requestId);
+    }
+    foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+    {
+        geospatialTask->cancelJobs(taskFilter);
+    }
+}
+
+void LocalGeospatialServer::prioritizeTask(QUuid const &requestId)
+{
+    // A queued execution the user is waiting for runs next
+    if (m_jobScheduler->changePriority(requestId, GeospatialJobScheduler::Priority::Interactive))
+    {
+        qDebug() << "Execution request" << requestId << "is interactive now.";
+    }
+
+    // Every job the execution request was split into runs next, including the ones not queued yet
+    if (!m_childRequestIds.contains(requestId))
+    {
+        return;
+    }
+
+    m_prioritizedRequestIds.insert(requestId);
+    foreach (QUuid const &childRequestId, m_childRequestIds[requestId])
+    {
+        m_jobScheduler->changePriority(childRequestId, GeospatialJobScheduler::Priority::Interactive);
+    }
+    qDebug() << "Split execution request" << requestId << "is interactive now.";
+}
+
+GeospatialJobScheduler* LocalGeospatialServer::jobScheduler() const
+{
+    return m_jobScheduler;
+}
+
+int LocalGeospatialServer::coldStartCount() const
+{
+    return m_coldStartCount;
+}
+
+int LocalGeospatialServer::warmHitCount() const
+{
+    return m_warmHitCount;
+}
+
+LocalGeoprocessingPackage* LocalGeospatialServer::geoprocessingPackage(QString const &packageFilePath)
+{
+    if (m_geoprocessingPackages.contains(packageFilePath))
+    {
+        return m_geoprocessingPackages[packageFilePath];
+    }
+
+    LocalGeoprocessingPackage *geoprocessingPackage = new LocalGeoprocessingPackage(packageFilePath, m_serviceScheduler, this);
+    geoprocessingPackage->setIdleTimeout(m_idleTimeout);
+    foreach (LocalGeospatialTask const *geospatialTask, m_geospatialTasks)
+    {
+        if (packageFilePath == geospatialTask->packageFilePath()
+                && m_tiledTaskNames.contains(geospatialTask->name()))
+        {
+            // Tiles are merged from the output features, a map image cannot be merged
+            geoprocessingPackage->setMapServerResult(false);
+            break;
+        }
+    }
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceStarted, this, [this, packageFilePath](LocalGeoprocessingService *localGpService)
+    {
+        addGeoprocessingTasks(packageFilePath, localGpService->url(), localGpService->serviceType());
+        emit servicesChanged();
+    });
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceStopped, this, [this, packageFilePath]()
+    {
+        unbindTasks(packageFilePath);
+        emit servicesChanged();
+    });
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::instanceStopped, this, [this, packageFilePath](LocalGeoprocessingService *localGpService)
+    {
+        foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+        {
+            if (packageFilePath == geospatialTask->packageFilePath())
+            {
+                geospatialTask->unbindTask(localGpService->url());
+            }
+        }
+        emit servicesChanged();
+    });
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceIdle, this, [this, geoprocessingPackage]()
+    {
+        stopIdleGeoprocessingPackage(geoprocessingPackage);
+    });
+    m_geoprocessingPackages.insert(packageFilePath, geoprocessingPackage);
+    m_serviceWatchdog->watch(geoprocessingPackage);
+    return geoprocessingPackage;
+}
+
+void LocalGeospatialServer::startGeoprocessing()
+{
+    foreach (QFileInfo const &fileInfo, m_geoprocessingPackageFiles)
+    {
+        QString packageFilePath = fileInfo.absoluteFilePath();
+        qDebug() << packageFilePath;
+        LocalGeoprocessingPackage *geoprocessingPackage = this->geoprocessingPackage(packageFilePath);
+
+        // Lazy packages are only started when their tasks are unknown
+        if (!m_lazyStart || !hasTasks(packageFilePath))
+        {
+            geoprocessingPackage->start();
+        }
+    }
+
+    // Start the packages requested before the local server was started
+    foreach (LocalGeoprocessingPackage *geoprocessingPackage, m_pendingPackageStarts)
+    {
+        geoprocessingPackage->start();
+    }
+    m_pendingPackageStarts.clear();
+}
+
+void LocalGeospatialServer::startGeoprocessingPackage(LocalGeoprocessingPackage *geoprocessingPackage)
+{
+    if (m_localServerStarted)
+    {
+        geoprocessingPackage->start();
+    }
+    else if (!m_pendingPackageStarts.contains(geoprocessingPackage))
+    {
+        m_pendingPackageStarts.append(geoprocessingPackage);
+    }
+}
+
+void LocalGeospatialServer::stopIdleGeoprocessingPackage(LocalGeoprocessingPackage *geoprocessingPackage)
+{
+    foreach (LocalGeospatialTask const *geospatialTask, m_geospatialTasks)
+    {
+        if (geoprocessingPackage->packageFilePath() == geospatialTask->packageFilePath()
+                && 0 < geospatialTask->outstandingJobCount())
+        {
+            // Jobs are still running or waiting to be created
+            geoprocessingPackage->touch();
+            return;
+        }
+    }
+
+    qDebug() << "Stopping idle service for" << geoprocessingPackage->packageFilePath();
+    geoprocessingPackage->stop();
+}
+
+void LocalGeospatialServer::growServicePools()
+{
+    if (m_maxServiceInstances <= 1)
+    {
+        return;
+    }
+
+    // A package gets another instance when its jobs queue up behind saturated instances
+    foreach (LocalGeoprocessingPackage *geoprocessingPackage, m_geoprocessingPackages)
+    {
+        if (!geoprocessingPackage->isStarted()
+                || geoprocessingPackage->isInstanceStarting()
+                || m_maxServiceInstances <= geoprocessingPackage->instanceCount())
+        {
+            continue;
+        }
+
+        QString packageFilePath = geoprocessingPackage->packageFilePath();
+        int serviceCapacity = m_jobScheduler->serviceConcurrencyLimit() * geoprocessingPackage->instanceCount();
+        if (0 < m_jobScheduler->queueDepth(packageFilePath)
+                && serviceCapacity <= m_jobScheduler->runningJobCount(packageFilePath))
+        {
+            qDebug() << "Adding service instance" << (geoprocessingPackage->instanceCount() + 1) << "for" << packageFilePath;
+            geoprocessingPackage->addInstance();
+        }
+    }
+}
+
+void LocalGeospatialServer::shrinkServicePools()
+{
+    foreach (LocalGeoprocessingPackage *geoprocessingPackage, m_geoprocessingPackages)
+    {
+        QList<LocalGeoprocessingService*> additionalServices = geoprocessingPackage->additionalServices();
+        if (additionalServices.isEmpty())
+        {
+            continue;
+        }
+
+        // The remaining instances must be able to run every job of the package
+        QString packageFilePath = geoprocessingPackage->packageFilePath();
+        int remainingCapacity = m_jobScheduler->serviceConcurrencyLimit() * (geoprocessingPackage->instanceCount() - 1);
+        if (0 < m_jobScheduler->queueDepth(packageFilePath)
+                || remainingCapacity < m_jobScheduler->runningJobCount(packageFilePath))
+        {
+            continue;
+        }
+
+        // One idle instance is stopped per interval
+        foreach (LocalGeoprocessingService *additionalService, additionalServices)
+        {
+            int outstandingJobCount = 0;
+            foreach (LocalGeospatialTask const *geospatialTask, m_geospatialTasks)
+            {
+                if (packageFilePath == geospatialTask->packageFilePath())
+                {
+                    outstandingJobCount += geospatialTask->outstandingJobCount(additionalService->url());
+                }
+            }
+
+            if (0 == outstandingJobCount)
+            {
+                qDebug() << "Removing idle service instance" << additionalService->url() << "for" << packageFilePath;
+                geoprocessingPackage->removeInstance(additionalService);
+                break;
+            }
+        }
+    }
 }
 
-QFileInfoList LocalGeospatialServer::geoprocessingPackages() const
+void LocalGeospatialServer::unbindTasks(QString const &packageFilePath)
 {
-    QString pathKeyName = "geoint.modelpath";
-    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
-    if (systemEnvironment.contains(pathKeyName))
+    m_prewarmedPackages.remove(packageFilePath);
+    foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
     {
-        QString directoryPath = systemEnvironment.value(pathKeyName);
-        return listFiles(directoryPath, "*.gpkx");
+        if (packageFilePath == geospatialTask->packageFilePath())
+        {
+            geospatialTask->unbindTask();
+        }
     }
-
-    return QFileInfoList();
 }
 
-QFileInfoList LocalGeospatialServer::mapPackages() const
+bool LocalGeospatialServer::hasTasks(QString const &packageFilePath) const
 {
-    QString pathKeyName = "geoint.datapath";
-    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
-    if (systemEnvironment.contains(pathKeyName))
+    foreach (LocalGeospatialTask const *geospatialTask, m_geospatialTasks)
     {
-        QString directoryPath = systemEnvironment.value(pathKeyName);
-        return listFiles(directoryPath, "*.mpkx");
+        if (packageFilePath == geospatialTask->packageFilePath())
+        {
+            return true;
+        }
     }
 
-    return QFileInfoList();
+    return false;
 }
 
-QFileInfoList LocalGeospatialServer::mobileMapPackages() const
+void LocalGeospatialServer::startMapping()
 {
-    QString pathKeyName = "geoint.datapath";
-    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
-    if (systemEnvironment.contains(pathKeyName))
+    foreach (QFileInfo const &fileInfo, m_mapPackageFiles)
     {
-        QString directoryPath = systemEnvironment.value(pathKeyName);
-        return listFiles(directoryPath, "*.mmpk");
+        startMapPackage(fileInfo);
     }
 
-    return QFileInfoList();
-}
-
-QString LocalGeospatialServer::licenseFilePath() const
-{
-    return QDir::temp().filePath("geoint-engineer-license.lic");
+    startMapServiceGroups();
 }
 
-LocalGeospatialServer::Status LocalGeospatialServer::start()
+QList<QFileInfoList> LocalGeospatialServer::groupDatasets(QFileInfoList const &datasets) const
 {
-    if (!LocalServer::instance()->isInstallValid())
+    // Either a maximum number of layers per process or a fixed number of processes
+    int groupCount = m_mapServiceProcesses;
+    if (0 < m_mapServiceMaxLayers)
     {
-        return Status::Failed;
+        groupCount = qMax(1, (datasets.size() + m_mapServiceMaxLayers - 1) / m_mapServiceMaxLayers);
     }
 
-    connect(LocalServer::instance(), &LocalServer::statusChanged, this, &LocalGeospatialServer::statusChanged);
-
-    if (updateLicenseFromFile())
+    // A dataset keeps its group as long as the number of groups is unchanged,
+    // so that adding a dataset only restarts the service of its own group
+    QVector<QFileInfoList> hashedGroups(groupCount);
+    foreach (QFileInfo const &fileInfo, datasets)
     {
-        // License file can be used
+        hashedGroups[qHash(fileInfo.fileName()) % groupCount].append(fileInfo);
     }
-    else
+
+    QList<QFileInfoList> datasetGroups;
+    foreach (QFileInfoList hashedGroup, hashedGroups)
     {
-        // Connect to the portal instance
-        QString portalUrlKeyName = "arcgisruntime.portal.url";
-        QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
-        if (systemEnvironment.contains(portalUrlKeyName))
+        if (hashedGroup.isEmpty())
         {
-            QString portalUrl = systemEnvironment.value(portalUrlKeyName);
-
-            // Connect to the portal instance using credentials
-            QString portalUserKeyName = "arcgisruntime.portal.user";
-            QString portalSecretKeyName = "arcgisruntime.portal.secret";
-            if (systemEnvironment.contains(portalUserKeyName)
-                && systemEnvironment.contains(portalSecretKeyName))
-            {
-                QString user = systemEnvironment.value(portalUserKeyName);
-                QString secret = systemEnvironment.value(portalSecretKeyName);
+            continue;
+        }
 
-                Credential* portalCredential = new Credential(user, secret, this);
-                m_geospatialPortal = new Portal(portalUrl, portalCredential, this);
-            }
-            else
-            {
-                // Connect to the portal instance using SSO
-                m_geospatialPortal = new Portal(portalUrl, this);
-            }
+        // An overfull group is split in the order of the file names
+        if (m_mapServiceMaxLayers <= 0
+                || hashedGroup.size() <= m_mapServiceMaxLayers)
+        {
+            datasetGroups.append(hashedGroup);
+            continue;
         }
 
-        if (nullptr != m_geospatialPortal)
+        std::sort(hashedGroup.begin(), hashedGroup.end(), [](QFileInfo const &left, QFileInfo const &right)
         {
-            // License file cannot be used
-            connect(m_geospatialPortal, &Portal::loadStatusChanged, this, &LocalGeospatialServer::portalStatusChanged);
-            connect(m_geospatialPortal, &Portal::fetchLicenseInfoCompleted, this, [this](QUuid, const LicenseInfo& licenseInfo)
-            {
-                // Update and save license
-                updateLicense(&licenseInfo, true);
-            });
-            m_geospatialPortal->load();
+            return left.fileName() < right.fileName();
+        });
+        for (int datasetIndex = 0, datasetCount = hashedGroup.size(); datasetIndex < datasetCount; datasetIndex += m_mapServiceMaxLayers)
+        {
+            datasetGroups.append(hashedGroup.mid(datasetIndex, m_mapServiceMaxLayers));
         }
     }
 
-    return Status::Starting;
+    return datasetGroups;
 }
 
-void LocalGeospatialServer::executeTask(LocalGeospatialTask *geospatialTask, Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures)
+void LocalGeospatialServer::startMapServiceGroups()
 {
-    if (geospatialTask->hasInputFeaturesParameter())
+    if (m_mapServiceTemplateFilePath.isEmpty())
     {
-        geospatialTask->executeTask(inputFeatures);
+        return;
     }
-}
 
-void LocalGeospatialServer::executeTasks(GeoprocessingFeatures *inputFeatures)
-{
-    foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+    QList<LocalMapServiceGroup*> mapServiceGroups;
+    QList<LocalMapServiceGroup*> unusedGroups = m_mapServiceGroups;
+    foreach (QFileInfoList const &datasetGroup, groupDatasets(m_datasetFiles))
     {
-        if (geospatialTask->hasInputFeaturesParameter())
+        // Unchanged groups keep their running service
+        LocalMapServiceGroup *mapServiceGroup = nullptr;
+        foreach (LocalMapServiceGroup *knownGroup, unusedGroups)
         {
-            geospatialTask->executeTask(inputFeatures);
+            QFileInfoList knownDatasets = knownGroup->datasets();
+            bool unchanged = knownDatasets.size() == datasetGroup.size();
+            foreach (QFileInfo const &fileInfo, datasetGroup)
+            {
+                unchanged = unchanged
+                        && containsPackage(knownDatasets, fileInfo.absoluteFilePath())
+                        && !isPackageModified(fileInfo, knownDatasets);
+            }
+            if (unchanged)
+            {
+                mapServiceGroup = knownGroup;
+                break;
+            }
         }
-    }
-}
 
-void LocalGeospatialServer::startGeoprocessing()
-{
-    QFileInfoList packages = geoprocessingPackages();
-    foreach (QFileInfo const &fileInfo, packages)
-    {
-        // Create a new local geoprocessing service with map server results
-        QString packageFilePath = fileInfo.absoluteFilePath();
-        qDebug() << packageFilePath;
-        LocalGeoprocessingService *localGpService = new LocalGeoprocessingService(packageFilePath, this);
-        // TODO: When is map server result supported?
-        if (packageFilePath.endsWith(".gpk"))
+        if (nullptr != mapServiceGroup)
         {
-            localGpService->setServiceType(GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult);
+            unusedGroups.removeOne(mapServiceGroup);
         }
         else
         {
-            //localGpService->setServiceType(GeoprocessingServiceType::SynchronousExecute);
-            localGpService->setServiceType(GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult);
+            mapServiceGroup = new LocalMapServiceGroup(m_mapServiceTemplateFilePath, datasetGroup, m_serviceScheduler, this);
+            connect(mapServiceGroup, &LocalMapServiceGroup::mapServiceLoaded, this, &LocalGeospatialServer::mapServiceLoaded);
+            connect(mapServiceGroup, &LocalMapServiceGroup::mapServiceRemoved, this, &LocalGeospatialServer::mapServiceRemoved);
+            mapServiceGroup->start();
         }
-        connect(localGpService, &LocalGeoprocessingService::statusChanged, this, [this, localGpService]()
-        {
-            switch (localGpService->status())
-            {
-            case LocalServerStatus::Starting:
-                qDebug() << "Local geospatial service " << localGpService->name() << " starting...";
-                break;
-
-            case LocalServerStatus::Started:
-                qDebug() << "Local geospatial service " << localGpService->name() << " started.";
-                qDebug() << localGpService->url();
-                addGeoprocessingTasks(localGpService);
-                break;
-
-            case LocalServerStatus::Stopping:
-                qDebug() << "Local geospatial service " << localGpService->name() << " stopping...";
-                break;
-
-            case LocalServerStatus::Stopped:
-                qDebug() << "Local geospatial service " << localGpService->name() << " stopped.";
-                break;
-
-            case LocalServerStatus::Failed:
-                qDebug() << "Local geospatial service " << localGpService->name() << " failed!";
-                break;
-            }
+        mapServiceGroups.append(mapServiceGroup);
+    }
 
-        });
-        localGpService->start();
+    foreach (LocalMapServiceGroup *unusedGroup, unusedGroups)
+    {
+        unusedGroup->stop();
+        unusedGroup->deleteLater();
     }
+
+    m_mapServiceGroups = mapServiceGroups;
 }
 
-void LocalGeospatialServer::startMapping()
+void LocalGeospatialServer::startMapPackage(QFileInfo const &fileInfo)
 {
-    QFileInfoList mobileMapPackages = this->mobileMapPackages();
-    foreach (QFileInfo const &fileInfo, mobileMapPackages)
+    // Create a new local map service
+    QString packageFilePath = fileInfo.absoluteFilePath();
+    LocalMapService *localMapService = new LocalMapService(packageFilePath, this);
+    qDebug() << packageFilePath;
+    connect(localMapService, &LocalMapService::statusChanged, this, [packageFilePath, localMapService, this]()
     {
-        // Create a new local geoprocessing service with map server results
-        QString packageFilePath = fileInfo.absoluteFilePath();
-        MobileMapPackage *mobileMapPackage = new MobileMapPackage(packageFilePath, this);
-        connect(mobileMapPackage, &MobileMapPackage::loadStatusChanged, this, [packageFilePath, mobileMapPackage, this](LoadStatus loadStatus)
+        switch (localMapService->status())
         {
-            switch (loadStatus)
+        case LocalServerStatus::Started:
             {
-            case LoadStatus::Loaded:
+                qDebug() << "Local map server using " << packageFilePath << " started.";
+                ArcGISMapImageLayer *mapImageLayer = new ArcGISMapImageLayer(localMapService->url(), this);
+                m_mapServiceLayers.insert(packageFilePath, mapImageLayer);
+                connect(mapImageLayer, &ArcGISMapImageLayer::loadStatusChanged, this, [this, mapImageLayer](LoadStatus loadStatus)
                 {
-                    qDebug() << "Local mobile map package " << packageFilePath << " loaded.";
-                    QList<Map*> offlineMaps = mobileMapPackage->maps();
-                    foreach (Map *offlineMap, offlineMaps)
+                    switch (loadStatus)
                     {
-                        emit mapLoaded(offlineMap);
-                    }
-                }
-                break;
+                    case LoadStatus::Loaded:
+                        {
+                            qDebug() << "Local map service " << mapImageLayer->url() << " loaded.";
+                            emit mapServiceLoaded(mapImageLayer);
+                        }
+                        break;
 
-            default:
-                break;
+                    default:
+                        break;
+                    }
+                });
+                mapImageLayer->load();
             }
-        });
-        mobileMapPackage->load();
+            break;
+
+        case LocalServerStatus::Failed:
+            qDebug() << "Local map server using " << packageFilePath << " failed!";
+            break;
+
+        default:
+            break;
+        }
+    });
+    m_mapServices.insert(packageFilePath, localMapService);
+    m_serviceScheduler->schedule(packageFilePath, localMapService);
+}
+
+void LocalGeospatialServer::stopMapPackage(QString const &packageFilePath)
+{
+    m_serviceScheduler->cancel(packageFilePath);
+    if (m_mapServiceLayers.contains(packageFilePath))
+    {
+        ArcGISMapImageLayer *mapImageLayer = m_mapServiceLayers.take(packageFilePath);
+        emit mapServiceRemoved(mapImageLayer);
+        mapImageLayer->deleteLater();
     }
 
-    QFileInfoList mapPackages = this->mapPackages();
-    foreach (QFileInfo const &fileInfo, mapPackages)
+    if (m_mapServices.contains(packageFilePath))
     {
-        // Create a new local geoprocessing service with map server results
-        QString packageFilePath = fileInfo.absoluteFilePath();
-        LocalMapService *localMapService = new LocalMapService(packageFilePath, this);
-        qDebug() << packageFilePath;
-        connect(localMapService, &LocalMapService::statusChanged, this, [packageFilePath, localMapService, this]()
+        LocalMapService *localMapService = m_mapServices.take(packageFilePath);
+        disconnect(localMapService, nullptr, this, nullptr);
+        if (LocalServerStatus::Started == localMapService->status())
         {
-            switch (localMapService->status())
+            connect(localMapService, &LocalMapService::statusChanged, localMapService, [localMapService]()
             {
-            case LocalServerStatus::Started:
+                if (LocalServerStatus::Stopped == localMapService->status())
                 {
-                    qDebug() << "Local map server using " << packageFilePath << " started.";
-                    ArcGISMapImageLayer *mapImageLayer = new ArcGISMapImageLayer(localMapService->url(), this);
-                    connect(mapImageLayer, &ArcGISMapImageLayer::loadStatusChanged, this, [this, mapImageLayer](LoadStatus loadStatus)
-                    {
-                        switch (loadStatus)
-                        {
-                        case LoadStatus::Loaded:
-                            {
-                                qDebug() << "Local map service " << mapImageLayer->url() << " loaded.";
-                                emit mapServiceLoaded(mapImageLayer);
-                            }
-                            break;
-
-                        default:
-                            break;
-                        }
-                    });
-                    mapImageLayer->load();
+                    localMapService->deleteLater();
                 }
-                break;
-
-            case LocalServerStatus::Failed:
-                qDebug() << "Local map server using " << packageFilePath << " failed!";
-                break;
-
-            default:
-                break;
-            }
-        });
-        localMapService->start();
+            });
+            localMapService->stop();
+        }
+        else
+        {
+            localMapService->deleteLater();
+        }
     }
 }
 
@@ -338,6 +1746,7 @@ void LocalGeospatialServer::saveLicense(LicenseInfo const *licenseInfo)
 void LocalGeospatialServer::updateLicense(LicenseInfo const *licenseInfo, bool save)
 {
     LicenseResult licenseResult = ArcGISRuntimeEnvironment::setLicense(*licenseInfo);
+    StartupTimeline::instance()->end("license");
     switch (licenseResult.licenseStatus())
     {
     case LicenseStatus::Valid:
@@ -348,7 +1757,7 @@ void LocalGeospatialServer::updateLicense(LicenseInfo const *licenseInfo, bool s
         }
 
         // Start the local server
-        LocalServer::start();
+        startLocalServer();
         break;
 
     case LicenseStatus::LoginRequired:
@@ -365,32 +1774,100 @@ void LocalGeospatialServer::updateLicense(LicenseInfo const *licenseInfo, bool s
     }
 }
 
-bool LocalGeospatialServer::updateLicenseFromFile()
+void LocalGeospatialServer::licenseFileValidated()
 {
-    QFile licenseFile(licenseFilePath());
-    if (licenseFile.exists())
+    // The runtime environment is only changed on the GUI thread
+    QString licenseJson = m_licenseFileWatcher.result();
+    if (!licenseJson.isEmpty())
     {
-        qDebug() << licenseFile.fileName();
-        licenseFile.open(QIODevice::ReadOnly);
-        LicenseInfo licenseInfo = LicenseInfo::fromJson(licenseFile.readAll());
+        LicenseInfo licenseInfo = LicenseInfo::fromJson(licenseJson);
         LicenseResult licenseResult = ArcGISRuntimeEnvironment::setLicense(licenseInfo);
         if (LicenseStatus::Valid == licenseResult.licenseStatus())
         {
-            // Start the local server
-            LocalServer::start();
-            return true;
+            // License file can be used
+            StartupTimeline::instance()->end("license");
+            startLocalServer();
+            return;
         }
     }
 
-    return false;
+    // Connect to the portal instance
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString portalUrlKeyName = "arcgisruntime.portal.url";
+    if (systemEnvironment.contains(portalUrlKeyName))
+    {
+        QString portalUrl = systemEnvironment.value(portalUrlKeyName);
+
+        // Connect to the portal instance using credentials
+        QString portalUserKeyName = "arcgisruntime.portal.user";
+        QString portalSecretKeyName = "arcgisruntime.portal.secret";
+        if (systemEnvironment.contains(portalUserKeyName)
+            && systemEnvironment.contains(portalSecretKeyName))
+        {
+            QString user = systemEnvironment.value(portalUserKeyName);
+            QString secret = systemEnvironment.value(portalSecretKeyName);
+
+            Credential* portalCredential = new Credential(user, secret, this);
+            m_geospatialPortal = new Portal(portalUrl, portalCredential, this);
+        }
+        else
+        {
+            // Connect to the portal instance using SSO
+            m_geospatialPortal = new Portal(portalUrl, this);
+        }
+    }
+
+    if (nullptr != m_geospatialPortal)
+    {
+        // License file cannot be used
+        connect(m_geospatialPortal, &Portal::loadStatusChanged, this, &LocalGeospatialServer::portalStatusChanged);
+        connect(m_geospatialPortal, &Portal::fetchLicenseInfoCompleted, this, [this](QUuid, const LicenseInfo& licenseInfo)
+        {
+            // Update and save license
+            updateLicense(&licenseInfo, true);
+        });
+        m_geospatialPortal->load();
+    }
+    else
+    {
+        qDebug() << "No license available!";
+        StartupTimeline::instance()->end("license");
+    }
+}
+
+QString LocalGeospatialServer::readLicenseFile() const
+{
+    // Runs on a worker thread while the QML engine is loaded, the file is only read and parsed here
+    QFile licenseFile(licenseFilePath());
+    if (!licenseFile.exists())
+    {
+        return QString();
+    }
+    if (!licenseFile.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "License file cannot be read:" << licenseFile.errorString();
+        return QString();
+    }
+
+    QJsonParseError parseError;
+    QJsonDocument licenseDocument = QJsonDocument::fromJson(licenseFile.readAll(), &parseError);
+    if (QJsonParseError::NoError != parseError.error
+            || !licenseDocument.isObject())
+    {
+        qDebug() << "License file is not valid JSON:" << parseError.errorString();
+        return QString();
+    }
+
+    return QString::fromUtf8(licenseDocument.toJson(QJsonDocument::Compact));
 }
 
-void LocalGeospatialServer::addGeoprocessingTasks(LocalGeoprocessingService *geoprocessingService)
+void LocalGeospatialServer::addGeoprocessingTasks(QString const &packageFilePath, QUrl const &serviceUrl, GeoprocessingServiceType serviceType)
 {
     // Start a request for accessing the available tasks
-    // Register the service type using the service endpoint url
-    QString infoEndpoint = geoprocessingService->url().toString() + "?f=json";
-    m_geoprocessingServiceTypes.insert(QUrl(infoEndpoint), geoprocessingService->serviceType());
+    // Register the service type and package using the service endpoint url
+    QString infoEndpoint = serviceUrl.toString() + "?f=json";
+    m_geoprocessingServiceTypes.insert(QUrl(infoEndpoint), serviceType);
+    m_geoprocessingPackagePaths.insert(QUrl(infoEndpoint), packageFilePath);
     QNetworkRequest geoprocessingInfoRequest(infoEndpoint);
     m_networkAccessManager->get(geoprocessingInfoRequest);
 }
@@ -418,6 +1895,10 @@ void LocalGeospatialServer::networkRequestFinished(QNetworkReply *networkReply)
 
     QJsonObject geoprocessingServiceObject = geoprocessingServiceDocument.object();
     QJsonArray geoprocessingTasksArray = geoprocessingServiceObject["tasks"].toArray();
+    QString servicePackageFilePath = m_geoprocessingPackagePaths.value(networkReply->url());
+    PendingCatalogEntry pendingCatalogEntry;
+    pendingCatalogEntry.remainingTasks = geoprocessingTasksArray.size();
+    m_pendingCatalogEntries.insert(servicePackageFilePath, pendingCatalogEntry);
     foreach (const QJsonValue &taskValue, geoprocessingTasksArray)
     {
         QUrl geoprocessingServiceUrl = networkReply->url();
@@ -430,8 +1911,9 @@ void LocalGeospatialServer::networkRequestFinished(QNetworkReply *networkReply)
         if (m_geoprocessingServiceTypes.contains(geoprocessingServiceUrl))
         {
             GeoprocessingServiceType serviceType = m_geoprocessingServiceTypes[geoprocessingServiceUrl];
+            QString packageFilePath = m_geoprocessingPackagePaths.value(geoprocessingServiceUrl);
             GeoprocessingTask *geoprocessingTask = new GeoprocessingTask(QUrl(geoprocessingTaskEndpoint), this);
-            connect(geoprocessingTask, &GeoprocessingTask::loadStatusChanged, this, [this, geoprocessingTask, serviceType]()
+            connect(geoprocessingTask, &GeoprocessingTask::loadStatusChanged, this, [this, geoprocessingTask, serviceType, packageFilePath]()
             {
                 LoadStatus taskLoadStatus = geoprocessingTask->loadStatus();
                 logLoadStatus("GP task ", taskLoadStatus);
@@ -440,16 +1922,31 @@ void LocalGeospatialServer::networkRequestFinished(QNetworkReply *networkReply)
                 {
                 case LoadStatus::Loaded:
                     {
-                        // Add a new geospatial task
-                        LocalGeospatialTask *geospatialTask = new LocalGeospatialTask(geoprocessingTask, serviceType, this);
-                        connect(geospatialTask, &LocalGeospatialTask::taskCompleted, this, &LocalGeospatialServer::localTaskCompleted);
-                        m_geospatialTasks.append(geospatialTask);
+                        // Bind the cached task or add a new geospatial task
+                        QString taskName = geoprocessingTask->geoprocessingTaskInfo().name();
+                        LocalGeospatialTask *geospatialTask = findTask(packageFilePath, taskName);
+                        if (nullptr != geospatialTask)
+                        {
+                            geospatialTask->bindTask(geoprocessingTask, serviceType);
+                        }
+                        else
+                        {
+                            geospatialTask = new LocalGeospatialTask(packageFilePath, GeospatialTaskInfo::fromTaskInfo(geoprocessingTask->geoprocessingTaskInfo(), serviceType), this);
+                            geospatialTask->bindTask(geoprocessingTask, serviceType);
+                            registerTask(geospatialTask);
+                        }
                         logGeoprocessingTaskInfos();
+                        useFeatureResults(geospatialTask, serviceType);
 
-                        // Emit the new geospatial task
-                        emit taskLoaded(geospatialTask);
+                        GeospatialTaskInfo taskInfo = geospatialTask->taskInfo();
+                        updateTaskCatalog(packageFilePath, &taskInfo);
                     }
                     break;
+
+                case LoadStatus::FailedToLoad:
+                    updateTaskCatalog(packageFilePath, nullptr);
+                    break;
+
                 default:
                     return;
                 }
@@ -463,6 +1960,152 @@ void LocalGeospatialServer::networkRequestFinished(QNetworkReply *networkReply)
     }
 }
 
+void LocalGeospatialServer::useFeatureResults(LocalGeospatialTask *geospatialTask, GeoprocessingServiceType serviceType)
+{
+    // A tiled task found in a service with map server results restarts it without them
+    if (nullptr != m_daemonClient
+            || GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult != serviceType
+            || !m_tiledTaskNames.contains(geospatialTask->name()))
+    {
+        return;
+    }
+
+    LocalGeoprocessingPackage *geoprocessingPackage = this->geoprocessingPackage(geospatialTask->packageFilePath());
+    if (geoprocessingPackage->hasMapServerResult())
+    {
+        qDebug() << "Restarting" << geospatialTask->packageFilePath() << "without map server results for the tiled task" << geospatialTask->name();
+        geoprocessingPackage->setMapServerResult(false);
+        geoprocessingPackage->restart();
+    }
+}
+
+LocalGeospatialTask* LocalGeospatialServer::findTask(QString const &packageFilePath, QString const &taskName) const
+{
+    foreach (LocalGeospatialTask *geospatialTask, m_geospatialTasks)
+    {
+        if (packageFilePath == geospatialTask->packageFilePath()
+                && taskName == geospatialTask->name())
+        {
+            return geospatialTask;
+        }
+    }
+
+    return nullptr;
+}
+
+void LocalGeospatialServer::registerTask(LocalGeospatialTask *geospatialTask)
+{
+    connect(geospatialTask, &LocalGeospatialTask::taskCompleted, this, &LocalGeospatialServer::localTaskCompleted);
+    connect(geospatialTask, &LocalGeospatialTask::jobFinished, this, &LocalGeospatialServer::localJobFinished);
+    connect(geospatialTask, &LocalGeospatialTask::jobFinished, this, [this, geospatialTask]()
+    {
+        m_jobScheduler->finishJob(geospatialTask);
+    });
+    geospatialTask->setSynchronousThreshold(m_synchronousThreshold);
+    geospatialTask->setInputUploads(m_inputUploads);
+    if (m_handoffTaskNames.contains(geospatialTask->name()))
+    {
+        geospatialTask->setDatasetHandoff(m_datasetHandoff, m_handoffParameterName);
+    }
+    connect(geospatialTask, &LocalGeospatialTask::executionStatisticsChanged, this, [this, geospatialTask]()
+    {
+        qDebug() << geospatialTask->name() << "average latency asynchronous:" << geospatialTask->averageLatency(LocalGeospatialTask::ExecutionMode::Asynchronous)
+                 << "ms synchronous:" << geospatialTask->averageLatency(LocalGeospatialTask::ExecutionMode::Synchronous) << "ms";
+        if (LocalGeospatialTask::ExecutionMode::Synchronous == geospatialTask->executionMode()
+                && !geospatialTask->hasInstance(LocalGeospatialTask::ExecutionMode::Synchronous)
+                && m_geoprocessingPackages.contains(geospatialTask->packageFilePath()))
+        {
+            m_geoprocessingPackages[geospatialTask->packageFilePath()]->startSynchronousService();
+        }
+    });
+    connect(geospatialTask, &LocalGeospatialTask::taskBound, this, [this, geospatialTask]()
+    {
+        StartupTimeline::instance()->mark("first.task.executable");
+        prewarmService(geospatialTask);
+    });
+    m_geospatialTasks.append(geospatialTask);
+    StartupTimeline::instance()->mark("first.task.listed");
+    if (geospatialTask->isBound())
+    {
+        StartupTimeline::instance()->mark("first.task.executable");
+        prewarmService(geospatialTask);
+    }
+
+    // Emit the new geospatial task
+    emit taskLoaded(geospatialTask);
+}
+
+void LocalGeospatialServer::prewarmService(LocalGeospatialTask *geospatialTask)
+{
+    if (nullptr == m_servicePrewarmer
+            || !geospatialTask->hasInputFeaturesParameter()
+            || m_prewarmedPackages.contains(geospatialTask->packageFilePath()))
+    {
+        return;
+    }
+
+    // One task per service is enough to load the runtime of the server process
+    m_prewarmedPackages.insert(geospatialTask->packageFilePath());
+    m_servicePrewarmer->prewarm(geospatialTask);
+}
+
+void LocalGeospatialServer::updateTaskCatalog(QString const &packageFilePath, GeospatialTaskInfo const *taskInfo)
+{
+    if (!m_pendingCatalogEntries.contains(packageFilePath))
+    {
+        return;
+    }
+
+    PendingCatalogEntry &pendingCatalogEntry = m_pendingCatalogEntries[packageFilePath];
+    pendingCatalogEntry.remainingTasks--;
+    if (nullptr != taskInfo)
+    {
+        pendingCatalogEntry.taskInfos.append(*taskInfo);
+    }
+
+    if (0 < pendingCatalogEntry.remainingTasks)
+    {
+        return;
+    }
+
+    // All tasks of the service were loaded
+    QFileInfo packageFileInfo(packageFilePath);
+    m_taskCatalog.update(packageFileInfo, pendingCatalogEntry.taskInfos);
+    m_taskCatalog.save();
+    if (m_taskCatalog.contentHash(packageFilePath).isEmpty())
+    {
+        hashPackage(packageFileInfo);
+    }
+
+    // Tasks which are no longer part of a replaced package
+    QStringList liveTaskNames;
+    foreach (GeospatialTaskInfo const &liveTaskInfo, pendingCatalogEntry.taskInfos)
+    {
+        liveTaskNames.append(liveTaskInfo.name);
+    }
+    m_pendingCatalogEntries.remove(packageFilePath);
+    removeTasks(packageFilePath, liveTaskNames);
+}
+
+void LocalGeospatialServer::hashPackage(QFileInfo const &packageFileInfo)
+{
+    // Hashing a large package would block the GUI thread
+    QString packageFilePath = packageFileInfo.absoluteFilePath();
+    QFutureWatcher<QByteArray> *hashWatcher = new QFutureWatcher<QByteArray>(this);
+    connect(hashWatcher, &QFutureWatcher<QByteArray>::finished, this, [this, hashWatcher, packageFileInfo]()
+    {
+        hashWatcher->deleteLater();
+        if (m_taskCatalog.setContentHash(packageFileInfo, hashWatcher->result()))
+        {
+            m_taskCatalog.save();
+        }
+    });
+    hashWatcher->setFuture(QtConcurrent::run([packageFilePath]()
+    {
+        return GeospatialTaskCatalog::computeContentHash(packageFilePath);
+    }));
+}
+
 void LocalGeospatialServer::logGeoprocessingTaskInfos()
 {
     foreach (LocalGeospatialTask const *geospatialTask, m_geospatialTasks)
@@ -516,6 +2159,7 @@ void LocalGeospatialServer::portalStatusChanged()
 
     case LoadStatus::FailedToLoad:
         qDebug() << "Portal failed to load!";
+        StartupTimeline::instance()->end("license");
         break;
 
     case LoadStatus::Unknown:
@@ -534,8 +2178,9 @@ void LocalGeospatialServer::statusChanged()
 
     case LocalServerStatus::Started:
         qDebug() << "Local geospatial server started.";
-        startGeoprocessing();
-        startMapping();
+        StartupTimeline::instance()->end("localserver.start");
+        m_localServerStarted = true;
+        startServicesWhenReady();
         break;
 
     case LocalServerStatus::Stopping:
@@ -544,16 +2189,72 @@ void LocalGeospatialServer::statusChanged()
 
     case LocalServerStatus::Stopped:
         qDebug() << "Local geospatial server stopped.";
+        m_localServerStarted = false;
+        m_servicesStarted = false;
         break;
 
     case LocalServerStatus::Failed:
         qDebug() << "Local geospatial server failed!";
         qDebug() << LocalServer::installPath();
+        StartupTimeline::instance()->end("localserver.start");
+        m_status = Status::Failed;
         break;
     }
 }
 
-void LocalGeospatialServer::localTaskCompleted(GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult)
+void LocalGeospatialServer::localTaskCompleted(QUuid const &requestId, GeoprocessingResult *result, ArcGISMapImageLayer *mapImageLayerResult)
+{
+    if (m_resultKeys.contains(requestId))
+    {
+        QByteArray resultKey = m_resultKeys.take(requestId);
+        GeospatialResultCache::CachedResult cachedResult;
+        ArcGISMapImageLayer *resultMapImageLayer = (nullptr != result->mapImageLayer()) ? result->mapImageLayer() : mapImageLayerResult;
+        if (nullptr != resultMapImageLayer)
+        {
+            // A map image result is drawn from its service, the output features are not needed
+            cachedResult.mapImageLayerUrl = resultMapImageLayer->url();
+            m_resultCache.store(resultKey, cachedResult);
+        }
+        else
+        {
+            // Serializing large output features would block the GUI thread
+            // the worker only reads a copy of the output features
+            FeatureCollection *outputFeatureCollection = GeospatialResultCache::copyFeatures(result);
+            if (nullptr == outputFeatureCollection)
+            {
+                m_resultCache.store(resultKey, cachedResult);
+            }
+            else
+            {
+                QFutureWatcher<QString> *serializeWatcher = new QFutureWatcher<QString>(this);
+                connect(serializeWatcher, &QFutureWatcher<QString>::finished, this, [this, serializeWatcher, outputFeatureCollection, resultKey]()
+                {
+                    serializeWatcher->deleteLater();
+                    delete outputFeatureCollection;
+                    GeospatialResultCache::CachedResult serializedResult;
+                    serializedResult.featureCollectionJson = serializeWatcher->result();
+                    m_resultCache.store(resultKey, serializedResult);
+                });
+                serializeWatcher->setFuture(QtConcurrent::run([outputFeatureCollection]()
+                {
+                    return outputFeatureCollection->toJson();
+                }));
+            }
+        }
+    }
+
+    completeTask(requestId, result, mapImageLayerResult, nullptr);
+}
+
+void LocalGeospatialServer::localJobFinished(QUuid const &requestId)
 {
-    emit taskCompleted(result, mapImageLayerResult);
+    // Failed jobs leave nothing to cache and report an empty result to their sink
+    m_resultKeys.remove(requestId);
+    m_requestInputVersions.remove(requestId);
+    m_datasetHandoff->releaseDataset(requestId);
+    if (m_resultSinks.contains(requestId))
+    {
+        GeospatialResultSink resultSink = m_resultSinks.take(requestId);
+        resultSink(requestId, nullptr, nullptr, nullptr);
+    }
 }
@@ -26,29 +26,54 @@
 #ifndef LOCALGEOSPATIALSERVER_H
 #define LOCALGEOSPATIALSERVER_H
 
+class GeospatialDatasetHandoff;
+class GeospatialInputUploads;
+class LocalGeoprocessingPackage;
 class LocalGeospatialTask;
+class LocalMapServiceGroup;
+class LocalServiceDaemonClient;
+class LocalServicePrewarmer;
+class LocalServiceScheduler;
+class LocalServiceWatchdog;
 
 namespace Esri
 {
 namespace ArcGISRuntime
 {
 class ArcGISMapImageLayer;
+class FeatureCollection;
+class Geometry;
 class GeoprocessingFeatures;
 class GeoprocessingTask;
+class GroupLayer;
 class GeoprocessingResult;
+class Layer;
 class LicenseInfo;
 enum class LoadStatus;
 class LocalGeoprocessingService;
-class Map;
+class LocalMapService;
 class Portal;
 }
 }
 
+#include "GeospatialJobScheduler.h"
+#include "GeospatialParameterSweep.h"
+#include "GeospatialPipelineDefinition.h"
+#include "GeospatialResultCache.h"
+#include "GeospatialTaskCatalog.h"
+#include "GeospatialTaskContext.h"
+#include "GeospatialTimeWindows.h"
+
 #include "LocalServerTypes.h"
 
 #include <QFileInfoList>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QJsonArray>
 #include <QNetworkAccessManager>
 #include <QObject>
+#include <QSet>
+#include <QTimer>
 #include <QUuid>
 
 class LocalGeospatialServer : public QObject
@@ -57,6 +82,8 @@ class LocalGeospatialServer : public QObject
 public:
     explicit LocalGeospatialServer(QObject *parent = nullptr);
 
+    static LocalGeospatialServer* instance();
+
     enum class Status {
         Stopped = 0,
         Starting = 1,
@@ -65,45 +92,180 @@ public:
     };
     Status start();
 
-    void executeTask(LocalGeospatialTask *geospatialTask, Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures);
-    void executeTasks(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures);
+    QList<LocalGeospatialTask*> tasks() const;
+    QStringList mobileMapPackageFilePaths() const;
+
+    QUuid executeTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext);
+    QUuid speculateTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext);
+    QUuid executeSweep(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialParameterSweep const &parameterSweep);
+    QUuid executeTimeSlices(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialTimeWindows const &timeWindows);
+    void executeTasks(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures, Esri::ArcGISRuntime::Geometry const &inputGeometry, quint64 inputVersion = 0);
+    QStringList pipelineNames() const;
+    QUuid executePipeline(QString const &pipelineName, GeospatialTaskContext const &pipelineContext);
+    quint64 supersedeInputs();
+    void cancelTask(QUuid const &requestId);
+    void prioritizeTask(QUuid const &requestId);
+    void useGeoprocessingPackage(QString const &packageFilePath);
+    bool useSharedGeoprocessingPackage(QString const &packageFilePath);
+    GeospatialJobScheduler* jobScheduler() const;
+
+    QJsonArray serviceDirectory() const;
+
+    int coldStartCount() const;
+    int warmHitCount() const;
 
 signals:
-    void mapLoaded(Esri::ArcGISRuntime::Map *map);
     void mapServiceLoaded(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
+    void mapServiceRemoved(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
+    void mobileMapPackageAdded(QString const &packageFilePath);
+    void mobileMapPackageRemoved(QString const &packageFilePath);
+    void servicesChanged();
     void taskLoaded(LocalGeospatialTask *geospatialTask);
-    void taskCompleted(Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
+    void taskRemoved(LocalGeospatialTask *geospatialTask);
+    void taskCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    void sweepCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer);
+    void timeWindowCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GroupLayer *groupLayer, Esri::ArcGISRuntime::Layer *windowLayer);
 
 private slots:
     void networkRequestFinished(QNetworkReply *networkReply);
     void portalStatusChanged();
     void statusChanged();
-    void localTaskCompleted(Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
+    void localTaskCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
+    void localJobFinished(QUuid const &requestId);
+    void packagesEnumerated();
+    void licenseFileValidated();
+    void reloadPackages();
+    void daemonAttached();
+    void daemonAttachFailed();
+    void daemonDetached();
+    void attachServices(QJsonArray const &services);
+    void runTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext);
+    void growServicePools();
+    void shrinkServicePools();
 
 private:
+    struct PackageEnumeration {
+        QFileInfoList geoprocessingPackages;
+        QFileInfoList mapPackages;
+        QFileInfoList mobileMapPackages;
+        QFileInfoList datasets;
+        GeospatialTaskCatalog taskCatalog;
+        QMap<QString, QList<GeospatialTaskInfo>> cachedTaskInfos;
+    };
+
     QString licenseFilePath() const;
+    PackageEnumeration enumeratePackages() const;
+    void startLocalServer();
+    void startServicesWhenReady();
 
     QFileInfoList listFiles(QString const &directoryPath, QString const &fileExtension) const;
     QFileInfoList geoprocessingPackages() const;
+    LocalGeoprocessingPackage* geoprocessingPackage(QString const &packageFilePath);
     void startGeoprocessing();
+    void startGeoprocessingPackage(LocalGeoprocessingPackage *geoprocessingPackage);
+    void stopIdleGeoprocessingPackage(LocalGeoprocessingPackage *geoprocessingPackage);
+    void unbindTasks(QString const &packageFilePath);
+    bool hasTasks(QString const &packageFilePath) const;
     void startMapping();
+    void startMapPackage(QFileInfo const &fileInfo);
+    void stopMapPackage(QString const &packageFilePath);
+    QList<QFileInfoList> groupDatasets(QFileInfoList const &datasets) const;
+    void startMapServiceGroups();
+    void removeGeoprocessingPackage(QString const &packageFilePath);
+    void removeTasks(QString const &packageFilePath, QStringList const &keptTaskNames);
+
+    QStringList packageDirectories() const;
+    void watchPackageDirectories();
+    static bool isPackageModified(QFileInfo const &fileInfo, QFileInfoList const &knownFiles);
+    static bool containsPackage(QFileInfoList const &files, QString const &packageFilePath);
 
     QFileInfoList mapPackages() const;
     QFileInfoList mobileMapPackages() const;
+    QFileInfoList datasets() const;
 
     void saveLicense(Esri::ArcGISRuntime::LicenseInfo const *licenseInfo);
     void updateLicense(Esri::ArcGISRuntime::LicenseInfo const *licenseInfo, bool save);
-    bool updateLicenseFromFile();
+    QString readLicenseFile() const;
 
-    void addGeoprocessingTasks(Esri::ArcGISRuntime::LocalGeoprocessingService *geoprocessingService);
+    void addGeoprocessingTasks(QString const &packageFilePath, QUrl const &serviceUrl, Esri::ArcGISRuntime::GeoprocessingServiceType serviceType);
+    void useFeatureResults(LocalGeospatialTask *geospatialTask, Esri::ArcGISRuntime::GeoprocessingServiceType serviceType);
+    LocalGeospatialTask* findTask(QString const &packageFilePath, QString const &taskName) const;
+    void registerTask(LocalGeospatialTask *geospatialTask);
+    void submitTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialJobScheduler::Priority priority);
+    void scheduleTask(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext, GeospatialJobScheduler::Priority priority);
+    void dropTask(GeospatialTaskContext const &taskContext);
+    void cancelTasks(GeospatialTaskFilter const &taskFilter);
+    bool completeFromCache(LocalGeospatialTask *geospatialTask, GeospatialTaskContext const &taskContext);
+    void completeTask(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult, Esri::ArcGISRuntime::FeatureCollection *featureCollectionResult);
+    void prewarmService(LocalGeospatialTask *geospatialTask);
+    void updateTaskCatalog(QString const &packageFilePath, GeospatialTaskInfo const *taskInfo);
+    void hashPackage(QFileInfo const &packageFileInfo);
 
     void logGeoprocessingTaskInfos();
     void logLoadStatus(QString const &prefix, Esri::ArcGISRuntime::LoadStatus loadStatus);
 
-    Esri::ArcGISRuntime::Portal* m_geospatialPortal;
+    struct PendingCatalogEntry {
+        int remainingTasks = 0;
+        QList<GeospatialTaskInfo> taskInfos;
+    };
+
+    Status m_status = Status::Stopped;
+    Esri::ArcGISRuntime::Portal* m_geospatialPortal = nullptr;
     QList<LocalGeospatialTask*> m_geospatialTasks;
     QMap<QUrl, Esri::ArcGISRuntime::GeoprocessingServiceType> m_geoprocessingServiceTypes;
+    QMap<QUrl, QString> m_geoprocessingPackagePaths;
+    GeospatialTaskCatalog m_taskCatalog;
+    QMap<QString, PendingCatalogEntry> m_pendingCatalogEntries;
     QNetworkAccessManager* m_networkAccessManager;
+    QFutureWatcher<PackageEnumeration> m_packageEnumerationWatcher;
+    QFutureWatcher<QString> m_licenseFileWatcher;
+    QFileInfoList m_geoprocessingPackageFiles;
+    QFileInfoList m_mapPackageFiles;
+    QFileInfoList m_mobileMapPackageFiles;
+    QFileInfoList m_datasetFiles;
+    bool m_packagesEnumerated = false;
+    QFileSystemWatcher m_packageWatcher;
+    QTimer m_packageReloadTimer;
+    QMap<QString, Esri::ArcGISRuntime::LocalMapService*> m_mapServices;
+    QMap<QString, Esri::ArcGISRuntime::ArcGISMapImageLayer*> m_mapServiceLayers;
+    QList<LocalMapServiceGroup*> m_mapServiceGroups;
+    QString m_mapServiceTemplateFilePath;
+    int m_mapServiceProcesses = 1;
+    int m_mapServiceMaxLayers = 0;
+    bool m_servicesStarted = false;
+    LocalServiceScheduler* m_serviceScheduler;
+    LocalServiceWatchdog* m_serviceWatchdog;
+    GeospatialJobScheduler* m_jobScheduler;
+    GeospatialInputUploads* m_inputUploads;
+    GeospatialDatasetHandoff* m_datasetHandoff;
+    QStringList m_handoffTaskNames;
+    QString m_handoffParameterName = "input_dataset";
+    GeospatialResultCache m_resultCache;
+    QMap<QUuid, QByteArray> m_resultKeys;
+    QMap<QUuid, GeospatialResultSink> m_resultSinks;
+    QMap<QUuid, QList<QUuid>> m_childRequestIds;
+    QSet<QUuid> m_prioritizedRequestIds;
+    quint64 m_inputVersion = 0;
+    QMap<QUuid, quint64> m_requestInputVersions;
+    int m_jobDeadline = 0;
+    QList<GeospatialPipelineDefinition> m_pipelineDefinitions;
+    QStringList m_tiledTaskNames;
+    int m_tileCount = 1;
+    double m_tileOverlap = 0.05;
+    LocalServiceDaemonClient* m_daemonClient = nullptr;
+    QMap<QString, QUrl> m_attachedServiceUrls;
+    LocalServicePrewarmer* m_servicePrewarmer = nullptr;
+    QSet<QString> m_prewarmedPackages;
+    QMap<QString, LocalGeoprocessingPackage*> m_geoprocessingPackages;
+    QList<LocalGeoprocessingPackage*> m_pendingPackageStarts;
+    bool m_localServerStarted = false;
+    bool m_lazyStart = false;
+    int m_idleTimeout = 0;
+    int m_maxServiceInstances = 1;
+    qint64 m_synchronousThreshold = 2000;
+    QTimer m_servicePoolTimer;
+    int m_coldStartCount = 0;
+    int m_warmHitCount = 0;
 };
 
 #endif // LOCALGEOSPATIALSERVER_H
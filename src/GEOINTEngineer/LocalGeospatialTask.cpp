@@ -23,16 +23,27 @@
 // See <https://developers.arcgis.com/qt/> for further information.
 
 
+#include "GeospatialDatasetHandoff.h"
+#include "GeospatialInputUploads.h"
 #include "LocalGeospatialTask.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QTimer>
 #include <QUrl>
 #include <QUuid>
 
 #include "ArcGISMapImageLayer.h"
+#include "Error.h"
+#include "GeoprocessingBoolean.h"
+#include "GeoprocessingDate.h"
+#include "GeoprocessingDouble.h"
 #include "GeoprocessingFeatures.h"
 #include "GeoprocessingJob.h"
+#include "GeoprocessingLinearUnit.h"
+#include "GeoprocessingLong.h"
 #include "GeoprocessingResult.h"
+#include "GeoprocessingString.h"
 #include "GeoprocessingTask.h"
 #include "GeoprocessingTaskInfo.h"
 #include "GeoprocessingTypes.h"
@@ -41,72 +52,437 @@
 
 using namespace Esri::ArcGISRuntime;
 
-LocalGeospatialTask::LocalGeospatialTask(GeoprocessingTask *geoprocessingTask, GeoprocessingServiceType serviceType, QObject *parent) :
+LocalGeospatialTask::LocalGeospatialTask(QString const &packageFilePath, GeospatialTaskInfo const &taskInfo, QObject *parent) :
     QObject(parent),
-    m_geoprocessingTask(geoprocessingTask),
-    m_serviceType(serviceType)
+    m_packageFilePath(packageFilePath),
+    m_taskInfo(taskInfo),
+    m_serviceType(taskInfo.serviceType)
 {
-    connect(geoprocessingTask, &GeoprocessingTask::createDefaultParametersCompleted, this, &LocalGeospatialTask::taskParametersCreated);
+}
+
+LocalGeospatialTask::~LocalGeospatialTask()
+{
+    qDeleteAll(m_serviceInstances);
+}
+
+QString LocalGeospatialTask::name() const
+{
+    return m_taskInfo.name;
 }
 
 QString LocalGeospatialTask::displayName() const
 {
-    return m_geoprocessingTask->geoprocessingTaskInfo().displayName();
+    return m_taskInfo.displayName;
 }
 
 QString LocalGeospatialTask::description() const
 {
-    return m_geoprocessingTask->geoprocessingTaskInfo().description();
+    return m_taskInfo.description;
+}
+
+QString LocalGeospatialTask::packageFilePath() const
+{
+    return m_packageFilePath;
+}
+
+QUrl LocalGeospatialTask::url() const
+{
+    if (m_serviceInstances.isEmpty())
+    {
+        return QUrl();
+    }
+
+    return m_serviceInstances.first()->geoprocessingTask->url();
+}
+
+QList<QUrl> LocalGeospatialTask::urls() const
+{
+    QList<QUrl> taskUrls;
+    foreach (ServiceInstance const *serviceInstance, m_serviceInstances)
+    {
+        taskUrls.append(serviceInstance->geoprocessingTask->url());
+    }
+
+    return taskUrls;
+}
+
+GeospatialTaskInfo LocalGeospatialTask::taskInfo() const
+{
+    return m_taskInfo;
+}
+
+QList<GeospatialParameterInfo> LocalGeospatialTask::parameters() const
+{
+    return m_taskInfo.parameters;
+}
+
+bool LocalGeospatialTask::isBound() const
+{
+    return !m_serviceInstances.isEmpty();
+}
+
+void LocalGeospatialTask::bindTask(GeoprocessingTask *geoprocessingTask, GeoprocessingServiceType serviceType)
+{
+    // A restarted service instance replaces the one with the same endpoint
+    unbindTask(geoprocessingTask->url());
+
+    // The live task replaces the cached metadata
+    ServiceInstance *serviceInstance = new ServiceInstance();
+    serviceInstance->geoprocessingTask = geoprocessingTask;
+    serviceInstance->serviceType = serviceType;
+    geoprocessingTask->setParent(this);
+    m_serviceInstances.append(serviceInstance);
+
+    // A synchronous variant does not change the service type of the task
+    if (GeoprocessingServiceType::SynchronousExecute != serviceType
+            || 1 == m_serviceInstances.size())
+    {
+        m_serviceType = serviceType;
+    }
+    m_taskInfo = GeospatialTaskInfo::fromTaskInfo(geoprocessingTask->geoprocessingTaskInfo(), m_serviceType);
+    connect(geoprocessingTask, &GeoprocessingTask::createDefaultParametersCompleted, this, [this, serviceInstance](QUuid parametersTaskId, GeoprocessingParameters const &defaultInputParameters)
+    {
+        taskParametersCreated(serviceInstance, parametersTaskId, defaultInputParameters);
+    });
+    connect(geoprocessingTask, &GeoprocessingTask::errorOccurred, this, [this, serviceInstance](Error const &error)
+    {
+        taskParametersFailed(serviceInstance, error);
+    });
+    emit taskBound();
+
+    // Executions requested before the service was started
+    QList<GeospatialTaskContext> pendingContexts = m_pendingContexts;
+    m_pendingContexts.clear();
+    foreach (GeospatialTaskContext const &taskContext, pendingContexts)
+    {
+        createParameters(leastLoadedInstance(taskContext), taskContext);
+    }
+}
+
+void LocalGeospatialTask::unbindTask()
+{
+    while (!m_serviceInstances.isEmpty())
+    {
+        removeInstance(m_serviceInstances.last());
+    }
+}
+
+void LocalGeospatialTask::unbindTask(QUrl const &serviceUrl)
+{
+    // The task endpoints are located beneath the service endpoint
+    QString serviceEndpoint = serviceUrl.toString();
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        QString taskEndpoint = serviceInstance->geoprocessingTask->url().toString();
+        if (taskEndpoint == serviceEndpoint
+                || taskEndpoint.startsWith(serviceEndpoint + "/"))
+        {
+            removeInstance(serviceInstance);
+        }
+    }
+
+    // Executions waiting for the removed instance move to the remaining ones
+    if (!m_serviceInstances.isEmpty())
+    {
+        QList<GeospatialTaskContext> pendingContexts = m_pendingContexts;
+        m_pendingContexts.clear();
+        foreach (GeospatialTaskContext const &taskContext, pendingContexts)
+        {
+            createParameters(leastLoadedInstance(taskContext), taskContext);
+        }
+    }
+}
+
+void LocalGeospatialTask::removeInstance(ServiceInstance *serviceInstance)
+{
+    // Keep the metadata, the task is bound again when its service was restarted
+    // and the default parameters of the restarted service are requested again
+    m_pendingContexts.append(serviceInstance->parameterWaiters);
+    m_pendingContexts.append(serviceInstance->uploadWaiters);
+
+    // Jobs of a stopped service never finish, jobs of a retiring service are not left running on it
+    for (auto jobIterator = serviceInstance->runningJobs.constBegin(); jobIterator != serviceInstance->runningJobs.constEnd(); ++jobIterator)
+    {
+        qDebug() << "Geoprocessing job of execution" << jobIterator.value().requestId << "lost its service!";
+        disconnect(jobIterator.key(), nullptr, this, nullptr);
+        jobIterator.key()->cancel();
+        m_runningJobCount--;
+        emit jobFinished(jobIterator.value().requestId);
+    }
+
+    disconnect(serviceInstance->geoprocessingTask, nullptr, this, nullptr);
+    serviceInstance->geoprocessingTask->deleteLater();
+    m_serviceInstances.removeOne(serviceInstance);
+    delete serviceInstance;
+}
+
+int LocalGeospatialTask::instanceCount() const
+{
+    return m_serviceInstances.size();
+}
+
+int LocalGeospatialTask::runningJobCount() const
+{
+    return m_runningJobCount;
+}
+
+int LocalGeospatialTask::outstandingJobCount() const
+{
+    // Executions waiting for the default parameters or an upload run on the service soon
+    int outstandingJobCount = m_runningJobCount;
+    foreach (ServiceInstance const *serviceInstance, m_serviceInstances)
+    {
+        outstandingJobCount += serviceInstance->parameterWaiters.size() + serviceInstance->uploadWaiters.size();
+    }
+
+    return outstandingJobCount;
+}
+
+int LocalGeospatialTask::outstandingJobCount(QUrl const &serviceUrl) const
+{
+    QString serviceEndpoint = serviceUrl.toString();
+    foreach (ServiceInstance const *serviceInstance, m_serviceInstances)
+    {
+        if (serviceInstance->geoprocessingTask->url().toString().startsWith(serviceEndpoint + "/"))
+        {
+            return serviceInstance->runningJobs.size() + serviceInstance->parameterWaiters.size() + serviceInstance->uploadWaiters.size();
+        }
+    }
+
+    return 0;
+}
+
+LocalGeospatialTask::ExecutionMode LocalGeospatialTask::serviceExecutionMode(GeoprocessingServiceType serviceType)
+{
+    return (GeoprocessingServiceType::SynchronousExecute == serviceType) ? ExecutionMode::Synchronous : ExecutionMode::Asynchronous;
+}
+
+LocalGeospatialTask::ExecutionMode LocalGeospatialTask::executionMode() const
+{
+    if (m_synchronousThreshold <= 0)
+    {
+        return ExecutionMode::Asynchronous;
+    }
+
+    // Measured synchronous executions decide on their own
+    int const synchronousIndex = static_cast<int>(ExecutionMode::Synchronous);
+    if (0 < m_latencySamples[synchronousIndex])
+    {
+        return (m_averageLatencies[synchronousIndex] <= m_synchronousThreshold) ? ExecutionMode::Synchronous : ExecutionMode::Asynchronous;
+    }
+
+    // Consistently fast asynchronous executions including the submit and poll overhead
+    const int MinimumSamples = 3;
+    int const asynchronousIndex = static_cast<int>(ExecutionMode::Asynchronous);
+    if (MinimumSamples <= m_latencySamples[asynchronousIndex]
+            && m_averageLatencies[asynchronousIndex] <= m_synchronousThreshold)
+    {
+        return ExecutionMode::Synchronous;
+    }
+
+    return ExecutionMode::Asynchronous;
+}
+
+bool LocalGeospatialTask::hasInstance(ExecutionMode executionMode) const
+{
+    foreach (ServiceInstance const *serviceInstance, m_serviceInstances)
+    {
+        if (executionMode == serviceExecutionMode(serviceInstance->serviceType))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+qint64 LocalGeospatialTask::averageLatency(ExecutionMode executionMode) const
+{
+    return m_averageLatencies[static_cast<int>(executionMode)];
+}
+
+void LocalGeospatialTask::setSynchronousThreshold(qint64 synchronousThreshold)
+{
+    m_synchronousThreshold = synchronousThreshold;
+}
+
+void LocalGeospatialTask::setInputUploads(GeospatialInputUploads *inputUploads)
+{
+    if (nullptr != m_inputUploads)
+    {
+        disconnect(m_inputUploads, nullptr, this, nullptr);
+    }
+
+    m_inputUploads = inputUploads;
+    if (nullptr != m_inputUploads)
+    {
+        connect(m_inputUploads, &GeospatialInputUploads::uploadFinished, this, &LocalGeospatialTask::inputUploadFinished);
+    }
+}
+
+void LocalGeospatialTask::setDatasetHandoff(GeospatialDatasetHandoff *datasetHandoff, QString const &handoffParameterName)
+{
+    if (nullptr != m_datasetHandoff)
+    {
+        disconnect(m_datasetHandoff, nullptr, this, nullptr);
+    }
+
+    m_datasetHandoff = datasetHandoff;
+    m_handoffParameterName = handoffParameterName;
+    if (nullptr != m_datasetHandoff)
+    {
+        connect(m_datasetHandoff, &GeospatialDatasetHandoff::datasetFinished, this, &LocalGeospatialTask::inputDatasetFinished);
+    }
 }
 
-QList<GeoprocessingParameterInfo> LocalGeospatialTask::parameters() const
+void LocalGeospatialTask::recordLatency(GeoprocessingServiceType serviceType, qint64 latency)
 {
-    return m_geoprocessingTask->geoprocessingTaskInfo().parameterInfos();
+    // Exponential moving average, recent executions weigh more
+    int modeIndex = static_cast<int>(serviceExecutionMode(serviceType));
+    if (0 == m_latencySamples[modeIndex])
+    {
+        m_averageLatencies[modeIndex] = latency;
+    }
+    else
+    {
+        m_averageLatencies[modeIndex] = qRound64(0.3 * latency + 0.7 * m_averageLatencies[modeIndex]);
+    }
+    m_latencySamples[modeIndex]++;
+    emit executionStatisticsChanged();
+}
+
+LocalGeospatialTask::ServiceInstance* LocalGeospatialTask::leastLoadedInstance(GeospatialTaskContext const &taskContext) const
+{
+    // Jobs go to the instance with the least outstanding work using the preferred execution mode,
+    // results referenced by other jobs need an asynchronous job on the server
+    ExecutionMode preferredMode = taskContext.resultByReference ? ExecutionMode::Asynchronous : executionMode();
+    bool preferredModeBound = hasInstance(preferredMode);
+    ServiceInstance *leastLoadedInstance = nullptr;
+    int leastOutstandingWork = 0;
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        if (preferredModeBound
+                && preferredMode != serviceExecutionMode(serviceInstance->serviceType))
+        {
+            continue;
+        }
+
+        int outstandingWork = serviceInstance->runningJobs.size() + serviceInstance->parameterWaiters.size() + serviceInstance->uploadWaiters.size();
+        if (nullptr == leastLoadedInstance || outstandingWork < leastOutstandingWork)
+        {
+            leastLoadedInstance = serviceInstance;
+            leastOutstandingWork = outstandingWork;
+        }
+    }
+
+    return leastLoadedInstance;
 }
 
 bool LocalGeospatialTask::hasInputFeaturesParameter() const
 {
-    GeoprocessingTaskInfo taskInfo = m_geoprocessingTask->geoprocessingTaskInfo();
-    QList<GeoprocessingParameterInfo> taskParameterInfos = taskInfo.parameterInfos();
-    foreach (GeoprocessingParameterInfo const &parameterInfo, taskParameterInfos)
+    return InvalidIndex != findFirstInputFeaturesParameter();
+}
+
+QString LocalGeospatialTask::inputFeaturesParameterName() const
+{
+    int parameterIndex = findFirstInputFeaturesParameter();
+    if (InvalidIndex == parameterIndex)
+    {
+        return QString();
+    }
+
+    return m_taskInfo.parameters[parameterIndex].name;
+}
+
+QUuid LocalGeospatialTask::executeTask(GeospatialTaskContext const &taskContext)
+{
+    if (!isBound())
+    {
+        qDebug() << "Geoprocessing task" << name() << "is not bound yet, execution" << taskContext.requestId << "is pending.";
+        m_pendingContexts.append(taskContext);
+        return taskContext.requestId;
+    }
+
+    createParameters(leastLoadedInstance(taskContext), taskContext);
+    return taskContext.requestId;
+}
+
+void LocalGeospatialTask::cancelJobs(GeospatialTaskFilter const &taskFilter)
+{
+    // Executions waiting for a service or for the default parameters are dropped
+    QList<QUuid> droppedRequestIds;
+    for (int contextIndex = m_pendingContexts.size() - 1; 0 <= contextIndex; contextIndex--)
     {
-        switch(parameterInfo.direction())
+        if (taskFilter(m_pendingContexts[contextIndex]))
         {
-        case GeoprocessingParameterDirection::Input:
-            switch (parameterInfo.dataType())
-            {
-            case GeoprocessingParameterType::GeoprocessingFeatures:
-                // Input parameter type is features
-                return true;
+            droppedRequestIds.prepend(m_pendingContexts.takeAt(contextIndex).requestId);
+        }
+    }
 
-            default:
-                break;
+    QList<GeoprocessingJob*> cancelledJobs;
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        QList<GeospatialTaskContext> &parameterWaiters = serviceInstance->parameterWaiters;
+        for (int contextIndex = parameterWaiters.size() - 1; 0 <= contextIndex; contextIndex--)
+        {
+            if (taskFilter(parameterWaiters[contextIndex]))
+            {
+                droppedRequestIds.prepend(parameterWaiters.takeAt(contextIndex).requestId);
             }
-            break;
+        }
+        QList<GeospatialTaskContext> &uploadWaiters = serviceInstance->uploadWaiters;
+        for (int contextIndex = uploadWaiters.size() - 1; 0 <= contextIndex; contextIndex--)
+        {
+            if (taskFilter(uploadWaiters[contextIndex]))
+            {
+                droppedRequestIds.prepend(uploadWaiters.takeAt(contextIndex).requestId);
+            }
+        }
 
-        default:
-            break;
+        for (auto jobIterator = serviceInstance->runningJobs.constBegin(); jobIterator != serviceInstance->runningJobs.constEnd(); ++jobIterator)
+        {
+            if (taskFilter(jobIterator.value()))
+            {
+                cancelledJobs.append(jobIterator.key());
+            }
         }
     }
 
-    return false;
+    foreach (QUuid const &requestId, droppedRequestIds)
+    {
+        qDebug() << "Execution" << requestId << "of" << m_taskInfo.name << "was cancelled.";
+        emit jobFinished(requestId);
+    }
+    foreach (GeoprocessingJob *cancelledJob, cancelledJobs)
+    {
+        cancelJob(cancelledJob);
+    }
 }
 
-void LocalGeospatialTask::executeTask(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures)
+void LocalGeospatialTask::createParameters(ServiceInstance *serviceInstance, GeospatialTaskContext const &taskContext)
 {
-    m_inputFeatures = inputFeatures;
-    m_geoprocessingTask->createDefaultParameters();
+    // The default parameters are requested once per bound service instance
+    if (serviceInstance->defaultParameters)
+    {
+        createJob(serviceInstance, taskContext);
+        return;
+    }
+
+    serviceInstance->parameterWaiters.append(taskContext);
+    if (serviceInstance->defaultParametersRequestId.isNull())
+    {
+        TaskWatcher parametersWatcher = serviceInstance->geoprocessingTask->createDefaultParameters();
+        serviceInstance->defaultParametersRequestId = parametersWatcher.taskId();
+    }
 }
 
 void LocalGeospatialTask::logInfos() const
 {
-    GeoprocessingTaskInfo taskInfo = m_geoprocessingTask->geoprocessingTaskInfo();
-    QList<GeoprocessingParameterInfo> taskParameterInfos = taskInfo.parameterInfos();
-    qDebug() << taskInfo.name();
-    foreach (GeoprocessingParameterInfo const &parameterInfo, taskParameterInfos)
+    qDebug() << m_taskInfo.name;
+    foreach (GeospatialParameterInfo const &parameterInfo, m_taskInfo.parameters)
     {
-        qDebug() << parameterInfo.name();
-        switch (parameterInfo.dataType())
+        qDebug() << parameterInfo.name;
+        switch (parameterInfo.dataType)
         {
         case GeoprocessingParameterType::GeoprocessingString:
             qDebug() << "GeoprocessingString";
@@ -124,16 +500,30 @@ void LocalGeospatialTask::logInfos() const
 
 int LocalGeospatialTask::findFirstInputFeaturesParameter() const
 {
-    GeoprocessingTaskInfo taskInfo = m_geoprocessingTask->geoprocessingTaskInfo();
-    QList<GeoprocessingParameterInfo> taskParameterInfos = taskInfo.parameterInfos();
+    QList<GeospatialParameterInfo> const &taskParameterInfos = m_taskInfo.parameters;
+
+    // Tasks reading their input from a dataset take its path by the configured string parameter
+    if (nullptr != m_datasetHandoff)
+    {
+        for (int index = 0, parameterCount = taskParameterInfos.length(); index < parameterCount; index++)
+        {
+            GeospatialParameterInfo const &parameterInfo = taskParameterInfos[index];
+            if (GeoprocessingParameterDirection::Input == parameterInfo.direction
+                    && GeoprocessingParameterType::GeoprocessingString == parameterInfo.dataType
+                    && m_handoffParameterName == parameterInfo.name)
+            {
+                return index;
+            }
+        }
+    }
 
     for (int index = 0, parameterCount = taskParameterInfos.length(); index < parameterCount; index++)
     {
-        GeoprocessingParameterInfo const &parameterInfo = taskParameterInfos[index];
-        switch(parameterInfo.direction())
+        GeospatialParameterInfo const &parameterInfo = taskParameterInfos[index];
+        switch(parameterInfo.direction)
         {
         case GeoprocessingParameterDirection::Input:
-            switch (parameterInfo.dataType())
+            switch (parameterInfo.dataType)
             {
             case GeoprocessingParameterType::GeoprocessingFeatures:
                 // Input parameter type is features
@@ -152,19 +542,157 @@ int LocalGeospatialTask::findFirstInputFeaturesParameter() const
     return InvalidIndex;
 }
 
-void LocalGeospatialTask::taskParametersCreated(QUuid, const Esri::ArcGISRuntime::GeoprocessingParameters &defaultInputParameters)
+void LocalGeospatialTask::taskParametersCreated(ServiceInstance *serviceInstance, QUuid parametersTaskId, const Esri::ArcGISRuntime::GeoprocessingParameters &defaultInputParameters)
+{
+    if (parametersTaskId != serviceInstance->defaultParametersRequestId)
+    {
+        return;
+    }
+
+    qDebug() << "Default parameters of" << m_taskInfo.name << "cached for" << serviceInstance->geoprocessingTask->url();
+    serviceInstance->defaultParametersRequestId = QUuid();
+    serviceInstance->defaultParameters.reset(new GeoprocessingParameters(defaultInputParameters));
+
+    QList<GeospatialTaskContext> parameterWaiters = serviceInstance->parameterWaiters;
+    serviceInstance->parameterWaiters.clear();
+    foreach (GeospatialTaskContext const &taskContext, parameterWaiters)
+    {
+        createJob(serviceInstance, taskContext);
+    }
+}
+
+void LocalGeospatialTask::taskParametersFailed(ServiceInstance *serviceInstance, Error const &error)
+{
+    if (serviceInstance->defaultParametersRequestId.isNull())
+    {
+        return;
+    }
+
+    // The next execution requests the default parameters again
+    qDebug() << "Default parameters of" << m_taskInfo.name << "failed for" << serviceInstance->geoprocessingTask->url() << error.message();
+    serviceInstance->defaultParametersRequestId = QUuid();
+
+    QList<GeospatialTaskContext> parameterWaiters = serviceInstance->parameterWaiters;
+    serviceInstance->parameterWaiters.clear();
+    foreach (GeospatialTaskContext const &taskContext, parameterWaiters)
+    {
+        emit jobFinished(taskContext.requestId);
+    }
+}
+
+GeoprocessingParameter* LocalGeospatialTask::cloneParameter(GeoprocessingParameter const *parameter, QObject *parent)
+{
+    switch (parameter->parameterType())
+    {
+    case GeoprocessingParameterType::GeoprocessingBoolean:
+        return new GeoprocessingBoolean(static_cast<GeoprocessingBoolean const*>(parameter)->value(), parent);
+
+    case GeoprocessingParameterType::GeoprocessingDate:
+        return new GeoprocessingDate(static_cast<GeoprocessingDate const*>(parameter)->value(), parent);
+
+    case GeoprocessingParameterType::GeoprocessingDouble:
+        return new GeoprocessingDouble(static_cast<GeoprocessingDouble const*>(parameter)->value(), parent);
+
+    case GeoprocessingParameterType::GeoprocessingLinearUnit:
+        {
+            GeoprocessingLinearUnit const *linearUnit = static_cast<GeoprocessingLinearUnit const*>(parameter);
+            return new GeoprocessingLinearUnit(linearUnit->value(), linearUnit->units(), parent);
+        }
+
+    case GeoprocessingParameterType::GeoprocessingLong:
+        return new GeoprocessingLong(static_cast<GeoprocessingLong const*>(parameter)->value(), parent);
+
+    case GeoprocessingParameterType::GeoprocessingString:
+        return new GeoprocessingString(static_cast<GeoprocessingString const*>(parameter)->value(), parent);
+
+    default:
+        // Feature, raster and file values cannot be copied
+        return nullptr;
+    }
+}
+
+void LocalGeospatialTask::createJob(ServiceInstance *serviceInstance, GeospatialTaskContext const &taskContext)
 {
     int parameterIndex = findFirstInputFeaturesParameter();
-    if (InvalidIndex == parameterIndex)
+    if (InvalidIndex == parameterIndex
+            || taskContext.hasExpired())
     {
+        emit jobFinished(taskContext.requestId);
         return;
     }
 
-    GeoprocessingTaskInfo taskInfo = m_geoprocessingTask->geoprocessingTaskInfo();
-    GeoprocessingParameterInfo parameterInfo = taskInfo.parameterInfos()[parameterIndex];
-    qDebug() << "Geoprocessing input parameters" << taskInfo.name() << "created.";
-    QMap<QString, GeoprocessingParameter*> inputs = defaultInputParameters.inputs();
-    inputs.insert(parameterInfo.name(), m_inputFeatures);
+    GeospatialParameterInfo parameterInfo = m_taskInfo.parameters[parameterIndex];
+    GeoprocessingParameter *inputParameter = taskContext.inputFeatures;
+    GeoprocessingString *datasetParameter = nullptr;
+    if (GeoprocessingParameterType::GeoprocessingString == parameterInfo.dataType)
+    {
+        // The job only receives the path of the dataset the input features were written to
+        m_datasetHandoff->acquireDataset(taskContext);
+        if (!m_datasetHandoff->hasFinished(taskContext))
+        {
+            serviceInstance->uploadWaiters.append(taskContext);
+            return;
+        }
+
+        QString datasetPath = m_datasetHandoff->datasetPath(taskContext);
+        if (datasetPath.isEmpty())
+        {
+            emit jobFinished(taskContext.requestId);
+            return;
+        }
+        datasetParameter = new GeoprocessingString(datasetPath, this);
+        inputParameter = datasetParameter;
+    }
+    else if (nullptr != m_inputUploads
+             && m_inputUploads->isUploadable(taskContext))
+    {
+        // Jobs reference the input features uploaded once to their service
+        QUrl serviceUrl = GeospatialInputUploads::serviceUrl(serviceInstance->geoprocessingTask->url());
+        if (!m_inputUploads->hasFinished(serviceUrl, taskContext))
+        {
+            serviceInstance->uploadWaiters.append(taskContext);
+            m_inputUploads->upload(serviceUrl, taskContext);
+            return;
+        }
+
+        GeoprocessingFeatures *uploadedFeatures = m_inputUploads->uploadedFeatures(serviceUrl, taskContext);
+        if (nullptr != uploadedFeatures)
+        {
+            inputParameter = uploadedFeatures;
+        }
+    }
+
+    // Every execution gets its own copy of the cached default parameters,
+    // the default values are shared by all executions of the service instance
+    GeoprocessingParameters const &defaultInputParameters = *serviceInstance->defaultParameters;
+    qDebug() << "Geoprocessing input parameters" << m_taskInfo.name << "created for" << taskContext.requestId;
+    QMap<QString, GeoprocessingParameter*> const defaultInputs = defaultInputParameters.inputs();
+    QMap<QString, GeoprocessingParameter*> inputs;
+    QList<GeoprocessingParameter*> clonedParameters;
+    for (auto defaultIterator = defaultInputs.constBegin(); defaultIterator != defaultInputs.constEnd(); ++defaultIterator)
+    {
+        if (parameterInfo.name == defaultIterator.key()
+                || taskContext.parameterOverrides.contains(defaultIterator.key()))
+        {
+            continue;
+        }
+
+        GeoprocessingParameter *clonedParameter = cloneParameter(defaultIterator.value(), this);
+        if (nullptr != clonedParameter)
+        {
+            clonedParameters.append(clonedParameter);
+            inputs.insert(defaultIterator.key(), clonedParameter);
+        }
+        else
+        {
+            inputs.insert(defaultIterator.key(), defaultIterator.value());
+        }
+    }
+    inputs.insert(parameterInfo.name, inputParameter);
+    for (auto overrideIterator = taskContext.parameterOverrides.constBegin(); overrideIterator != taskContext.parameterOverrides.constEnd(); ++overrideIterator)
+    {
+        inputs.insert(overrideIterator.key(), overrideIterator.value());
+    }
 
     // Define the execution type
     GeoprocessingParameters inputParameters(defaultInputParameters.executionType());
@@ -181,9 +709,12 @@ void LocalGeospatialTask::taskParametersCreated(QUuid, const Esri::ArcGISRuntime
         break;
     }
     inputParameters.setInputs(inputs);
+    inputParameters.setProcessSpatialReference(defaultInputParameters.processSpatialReference());
+    inputParameters.setOutputSpatialReference(defaultInputParameters.outputSpatialReference());
 
     // Log the service type
-    switch (m_serviceType)
+    GeoprocessingServiceType serviceType = serviceInstance->serviceType;
+    switch (serviceType)
     {
     case GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult:
         qDebug() << "Service type is asynchronous submit with map server result.";
@@ -196,8 +727,20 @@ void LocalGeospatialTask::taskParametersCreated(QUuid, const Esri::ArcGISRuntime
         break;
     }
 
-    GeoprocessingJob *newGeoprocessingJob = m_geoprocessingTask->createJob(inputParameters);
-    connect(newGeoprocessingJob, &GeoprocessingJob::jobDone, this, [this, newGeoprocessingJob]()
+    GeoprocessingTask *geoprocessingTask = serviceInstance->geoprocessingTask;
+    GeoprocessingJob *newGeoprocessingJob = geoprocessingTask->createJob(inputParameters);
+    serviceInstance->runningJobs.insert(newGeoprocessingJob, taskContext);
+    if (nullptr != datasetParameter)
+    {
+        datasetParameter->setParent(newGeoprocessingJob);
+    }
+    foreach (GeoprocessingParameter *clonedParameter, clonedParameters)
+    {
+        clonedParameter->setParent(newGeoprocessingJob);
+    }
+    QElapsedTimer jobTimer;
+    jobTimer.start();
+    connect(newGeoprocessingJob, &GeoprocessingJob::jobDone, this, [this, geoprocessingTask, serviceType, newGeoprocessingJob, jobTimer, taskContext]()
     {
         switch (newGeoprocessingJob->jobStatus())
         {
@@ -216,13 +759,15 @@ void LocalGeospatialTask::taskParametersCreated(QUuid, const Esri::ArcGISRuntime
         case JobStatus::Succeeded:
             {
                 qDebug() << "Geoprocessing job " << newGeoprocessingJob->serverJobId() << " succeeded.";
+                finishJob(newGeoprocessingJob);
+                recordLatency(serviceType, jobTimer.elapsed());
                 GeoprocessingResult *newGeoprocessingResult = newGeoprocessingJob->result();
                 ArcGISMapImageLayer *newMapImageLayer = nullptr;
-                if (GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult == m_serviceType
+                if (GeoprocessingServiceType::AsynchronousSubmitWithMapServerResult == serviceType
                         && nullptr == newGeoprocessingResult->mapImageLayer())
                 {
                     // TODO: Investigate why there is no map image layer!
-                    QString taskEndpoint = m_geoprocessingTask->url().toString();
+                    QString taskEndpoint = geoprocessingTask->url().toString();
                     const int Invalid_Index = -1;
                     int gpServerCharPos = taskEndpoint.lastIndexOf("/GPServer/");
                     if (Invalid_Index != gpServerCharPos)
@@ -233,16 +778,103 @@ void LocalGeospatialTask::taskParametersCreated(QUuid, const Esri::ArcGISRuntime
                 }
 
                 // Emit that a task succeeded
-                emit taskCompleted(newGeoprocessingResult, newMapImageLayer);
+                if (GeoprocessingServiceType::SynchronousExecute != serviceType)
+                {
+                    emit jobSucceeded(taskContext.requestId, QUrl(geoprocessingTask->url().toString() + "/jobs/" + newGeoprocessingJob->serverJobId()));
+                }
+                emit taskCompleted(taskContext.requestId, newGeoprocessingResult, newMapImageLayer);
+                emit jobFinished(taskContext.requestId);
             }
             break;
 
         case JobStatus::Failed:
             qDebug() << "Geoprocessing job " << newGeoprocessingJob->serverJobId() << " failed!";
+            finishJob(newGeoprocessingJob);
+            emit jobFinished(taskContext.requestId);
             break;
         }
     });
 
+    // Jobs still running at their deadline are cancelled
+    if (!taskContext.deadline.isForever())
+    {
+        QTimer::singleShot(taskContext.deadline.remainingTime(), newGeoprocessingJob, [this, newGeoprocessingJob]()
+        {
+            cancelJob(newGeoprocessingJob);
+        });
+    }
+
     qDebug() << "Geoprocessing job " << newGeoprocessingJob->serverJobId() << " starting...";
+    m_runningJobCount++;
     newGeoprocessingJob->start();
 }
+
+void LocalGeospatialTask::inputUploadFinished(QUrl const &serviceUrl)
+{
+    // Executions of other inputs keep waiting for their own upload
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        if (serviceUrl != GeospatialInputUploads::serviceUrl(serviceInstance->geoprocessingTask->url()))
+        {
+            continue;
+        }
+
+        QList<GeospatialTaskContext> uploadWaiters = serviceInstance->uploadWaiters;
+        serviceInstance->uploadWaiters.clear();
+        foreach (GeospatialTaskContext const &taskContext, uploadWaiters)
+        {
+            createJob(serviceInstance, taskContext);
+        }
+    }
+}
+
+void LocalGeospatialTask::inputDatasetFinished()
+{
+    // Executions of other inputs wait again for their own dataset or upload
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        QList<GeospatialTaskContext> uploadWaiters = serviceInstance->uploadWaiters;
+        serviceInstance->uploadWaiters.clear();
+        foreach (GeospatialTaskContext const &taskContext, uploadWaiters)
+        {
+            createJob(serviceInstance, taskContext);
+        }
+    }
+}
+
+void LocalGeospatialTask::cancelJob(GeoprocessingJob *geoprocessingJob)
+{
+    QUuid requestId;
+    foreach (ServiceInstance const *serviceInstance, m_serviceInstances)
+    {
+        if (serviceInstance->runningJobs.contains(geoprocessingJob))
+        {
+            requestId = serviceInstance->runningJobs.value(geoprocessingJob).requestId;
+            break;
+        }
+    }
+    if (requestId.isNull())
+    {
+        return;
+    }
+
+    // The cancelled job reports nothing, its execution ends right now
+    qDebug() << "Geoprocessing job " << geoprocessingJob->serverJobId() << " of execution" << requestId << "cancelled.";
+    disconnect(geoprocessingJob, nullptr, this, nullptr);
+    finishJob(geoprocessingJob);
+    geoprocessingJob->cancel();
+    emit jobFinished(requestId);
+}
+
+void LocalGeospatialTask::finishJob(GeoprocessingJob *geoprocessingJob)
+{
+    foreach (ServiceInstance *serviceInstance, m_serviceInstances)
+    {
+        if (serviceInstance->runningJobs.contains(geoprocessingJob))
+        {
+            serviceInstance->runningJobs.remove(geoprocessingJob);
+            break;
+        }
+    }
+    m_runningJobCount--;
+}
@@ -31,17 +31,30 @@ namespace Esri
 namespace ArcGISRuntime
 {
 class ArcGISMapImageLayer;
+class Error;
 class GeoprocessingFeatures;
+class GeoprocessingJob;
 class GeoprocessingTask;
 class GeoprocessingResult;
 }
 }
 
-#include "GeoprocessingParameterInfo.h"
+class GeospatialDatasetHandoff;
+class GeospatialInputUploads;
+
+#include "GeospatialTaskContext.h"
+#include "GeospatialTaskInfo.h"
+
 #include "GeoprocessingParameters.h"
 #include "LocalServerTypes.h"
 
+#include <QList>
+#include <QMap>
 #include <QObject>
+#include <QUrl>
+#include <QUuid>
+
+#include <memory>
 
 class LocalGeospatialTask : public QObject
 {
@@ -51,29 +64,94 @@ class LocalGeospatialTask : public QObject
     Q_PROPERTY(QString description READ description)
 
 public:
-    explicit LocalGeospatialTask(Esri::ArcGISRuntime::GeoprocessingTask *geoprocessingTask, Esri::ArcGISRuntime::GeoprocessingServiceType serviceType, QObject *parent = nullptr);
+    enum class ExecutionMode {
+        Asynchronous = 0,
+        Synchronous = 1
+    };
+    Q_ENUM(ExecutionMode)
+
+    explicit LocalGeospatialTask(QString const &packageFilePath, GeospatialTaskInfo const &taskInfo, QObject *parent = nullptr);
+    ~LocalGeospatialTask();
 
+    QString name() const;
     QString displayName() const;
     QString description() const;
-    QList<Esri::ArcGISRuntime::GeoprocessingParameterInfo> parameters() const;
+    QString packageFilePath() const;
+    QUrl url() const;
+    QList<QUrl> urls() const;
+    GeospatialTaskInfo taskInfo() const;
+    QList<GeospatialParameterInfo> parameters() const;
+
+    bool isBound() const;
+    void bindTask(Esri::ArcGISRuntime::GeoprocessingTask *geoprocessingTask, Esri::ArcGISRuntime::GeoprocessingServiceType serviceType);
+    void unbindTask();
+    void unbindTask(QUrl const &serviceUrl);
+    int instanceCount() const;
+    int runningJobCount() const;
+    int outstandingJobCount() const;
+    int outstandingJobCount(QUrl const &serviceUrl) const;
+
+    ExecutionMode executionMode() const;
+    bool hasInstance(ExecutionMode executionMode) const;
+    qint64 averageLatency(ExecutionMode executionMode) const;
+    void setSynchronousThreshold(qint64 synchronousThreshold);
+    void setInputUploads(GeospatialInputUploads *inputUploads);
+    void setDatasetHandoff(GeospatialDatasetHandoff *datasetHandoff, QString const &handoffParameterName);
 
     bool hasInputFeaturesParameter() const;
-    void executeTask(Esri::ArcGISRuntime::GeoprocessingFeatures *inputFeatures);
+    QString inputFeaturesParameterName() const;
+    QUuid executeTask(GeospatialTaskContext const &taskContext);
+    void cancelJobs(GeospatialTaskFilter const &taskFilter);
     void logInfos() const;
 
 signals:
-    void taskCompleted(Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
-
-private slots:
-    void taskParametersCreated(QUuid, const Esri::ArcGISRuntime::GeoprocessingParameters &defaultInputParameters);
+    void taskBound();
+    void executionStatisticsChanged();
+    void jobSucceeded(QUuid const &requestId, QUrl const &jobUrl);
+    void jobFinished(QUuid const &requestId);
+    void taskCompleted(QUuid const &requestId, Esri::ArcGISRuntime::GeoprocessingResult *result, Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayerResult);
 
 private:
+    // A geoprocessing service instance of the package the task is bound to
+    struct ServiceInstance {
+        Esri::ArcGISRuntime::GeoprocessingTask *geoprocessingTask = nullptr;
+        Esri::ArcGISRuntime::GeoprocessingServiceType serviceType;
+        std::unique_ptr<Esri::ArcGISRuntime::GeoprocessingParameters> defaultParameters;
+        QUuid defaultParametersRequestId;
+        QList<GeospatialTaskContext> parameterWaiters;
+        // Executions waiting for their input features to be uploaded or written to a dataset
+        QList<GeospatialTaskContext> uploadWaiters;
+        QMap<Esri::ArcGISRuntime::GeoprocessingJob*, GeospatialTaskContext> runningJobs;
+    };
+
     int findFirstInputFeaturesParameter() const;
+    ServiceInstance* leastLoadedInstance(GeospatialTaskContext const &taskContext) const;
+    void removeInstance(ServiceInstance *serviceInstance);
+    void createParameters(ServiceInstance *serviceInstance, GeospatialTaskContext const &taskContext);
+    void taskParametersCreated(ServiceInstance *serviceInstance, QUuid parametersTaskId, const Esri::ArcGISRuntime::GeoprocessingParameters &defaultInputParameters);
+    void taskParametersFailed(ServiceInstance *serviceInstance, Esri::ArcGISRuntime::Error const &error);
+    void createJob(ServiceInstance *serviceInstance, GeospatialTaskContext const &taskContext);
+    void inputUploadFinished(QUrl const &serviceUrl);
+    void inputDatasetFinished();
+    void finishJob(Esri::ArcGISRuntime::GeoprocessingJob *geoprocessingJob);
+    void cancelJob(Esri::ArcGISRuntime::GeoprocessingJob *geoprocessingJob);
+    void recordLatency(Esri::ArcGISRuntime::GeoprocessingServiceType serviceType, qint64 latency);
+    static ExecutionMode serviceExecutionMode(Esri::ArcGISRuntime::GeoprocessingServiceType serviceType);
+    static Esri::ArcGISRuntime::GeoprocessingParameter* cloneParameter(Esri::ArcGISRuntime::GeoprocessingParameter const *parameter, QObject *parent);
     const static int InvalidIndex = -1;
 
-    Esri::ArcGISRuntime::GeoprocessingTask* m_geoprocessingTask;
+    QString m_packageFilePath;
+    GeospatialTaskInfo m_taskInfo;
+    QList<ServiceInstance*> m_serviceInstances;
     Esri::ArcGISRuntime::GeoprocessingServiceType m_serviceType;
-    Esri::ArcGISRuntime::GeoprocessingFeatures* m_inputFeatures;
+    QList<GeospatialTaskContext> m_pendingContexts;
+    int m_runningJobCount = 0;
+    qint64 m_synchronousThreshold = 0;
+    GeospatialInputUploads *m_inputUploads = nullptr;
+    GeospatialDatasetHandoff *m_datasetHandoff = nullptr;
+    QString m_handoffParameterName;
+    qint64 m_averageLatencies[2] = { 0, 0 };
+    int m_latencySamples[2] = { 0, 0 };
 };
 
 #endif // LOCALGEOSPATIALTASK_H
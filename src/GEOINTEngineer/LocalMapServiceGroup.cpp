@@ -0,0 +1,240 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalMapServiceGroup.h"
+#include "LocalServiceScheduler.h"
+
+#include "ArcGISMapImageLayer.h"
+#include "ArcGISMapImageSublayer.h"
+#include "ArcGISSublayerListModel.h"
+#include "CoreTypes.h"
+#include "LocalMapService.h"
+#include "LocalServerTypes.h"
+#include "RasterSublayerSource.h"
+#include "RasterWorkspace.h"
+#include "ShapefileWorkspace.h"
+#include "TableSublayerSource.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QJsonObject>
+
+using namespace Esri::ArcGISRuntime;
+
+LocalMapServiceGroup::LocalMapServiceGroup(QString const &templateFilePath, QFileInfoList const &datasets, LocalServiceScheduler *serviceScheduler, QObject *parent) :
+    QObject(parent),
+    m_templateFilePath(templateFilePath),
+    m_datasets(datasets),
+    m_serviceScheduler(serviceScheduler)
+{
+    // Every group shares the same template package, the scheduler needs a distinct key
+    QStringList datasetPaths;
+    foreach (QFileInfo const &fileInfo, m_datasets)
+    {
+        datasetPaths.append(fileInfo.absoluteFilePath());
+    }
+    m_scheduleKey = m_templateFilePath + "?" + datasetPaths.join(QDir::listSeparator());
+}
+
+QFileInfoList LocalMapServiceGroup::datasets() const
+{
+    return m_datasets;
+}
+
+ArcGISMapImageLayer* LocalMapServiceGroup::mapImageLayer() const
+{
+    return m_mapImageLayer;
+}
+
+QString LocalMapServiceGroup::workspaceId(QFileInfo const &fileInfo) const
+{
+    // One workspace per directory and workspace type
+    QString workspaceType = "shp" == fileInfo.suffix().toLower() ? "shapefiles" : "rasters";
+    QStringList directoryPaths;
+    foreach (QFileInfo const &datasetInfo, m_datasets)
+    {
+        if (!directoryPaths.contains(datasetInfo.absolutePath()))
+        {
+            directoryPaths.append(datasetInfo.absolutePath());
+        }
+    }
+
+    return QString("%1%2").arg(workspaceType).arg(directoryPaths.indexOf(fileInfo.absolutePath()));
+}
+
+QList<DynamicWorkspace*> LocalMapServiceGroup::createWorkspaces()
+{
+    QList<DynamicWorkspace*> workspaces;
+    QStringList workspaceIds;
+    foreach (QFileInfo const &fileInfo, m_datasets)
+    {
+        QString workspaceId = this->workspaceId(fileInfo);
+        if (workspaceIds.contains(workspaceId))
+        {
+            continue;
+        }
+
+        workspaceIds.append(workspaceId);
+        if ("shp" == fileInfo.suffix().toLower())
+        {
+            workspaces.append(new ShapefileWorkspace(workspaceId, fileInfo.absolutePath(), this));
+        }
+        else
+        {
+            workspaces.append(new RasterWorkspace(workspaceId, fileInfo.absolutePath(), this));
+        }
+    }
+
+    return workspaces;
+}
+
+QJsonArray LocalMapServiceGroup::sublayerInfos() const
+{
+    QJsonArray sublayerInfos;
+    foreach (QFileInfo const &fileInfo, m_datasets)
+    {
+        QJsonObject sublayerInfo;
+        sublayerInfo.insert("name", fileInfo.completeBaseName());
+        sublayerInfo.insert("workspaceId", workspaceId(fileInfo));
+        sublayerInfo.insert("dataSourceName", fileInfo.fileName());
+        sublayerInfo.insert("raster", "shp" != fileInfo.suffix().toLower());
+        sublayerInfos.append(sublayerInfo);
+    }
+
+    return sublayerInfos;
+}
+
+void LocalMapServiceGroup::addSublayers(ArcGISMapImageLayer *mapImageLayer, QJsonArray const &sublayerInfos)
+{
+    // The dynamic sublayer ids follow the largest id of the template layers
+    ArcGISSublayerListModel *mapImageSublayers = mapImageLayer->mapImageSublayers();
+    qint64 firstSublayerId = 0;
+    for (int templateIndex = 0, templateCount = mapImageSublayers->size(); templateIndex < templateCount; templateIndex++)
+    {
+        firstSublayerId = qMax(firstSublayerId, mapImageSublayers->at(templateIndex)->id() + 1);
+    }
+
+    // Every dataset is drawn as a dynamic sublayer of the shared service
+    for (int sublayerIndex = 0, sublayerCount = sublayerInfos.size(); sublayerIndex < sublayerCount; sublayerIndex++)
+    {
+        QJsonObject sublayerInfo = sublayerInfos.at(sublayerIndex).toObject();
+        QString workspaceId = sublayerInfo["workspaceId"].toString();
+        QString dataSourceName = sublayerInfo["dataSourceName"].toString();
+        LayerSource *layerSource = nullptr;
+        if (sublayerInfo["raster"].toBool())
+        {
+            layerSource = new RasterSublayerSource(workspaceId, dataSourceName, mapImageLayer);
+        }
+        else
+        {
+            layerSource = new TableSublayerSource(workspaceId, dataSourceName, mapImageLayer);
+        }
+
+        ArcGISMapImageSublayer *sublayer = new ArcGISMapImageSublayer(firstSublayerId + sublayerIndex, layerSource, mapImageLayer);
+        sublayer->setName(sublayerInfo["name"].toString());
+        mapImageSublayers->append(sublayer);
+    }
+}
+
+void LocalMapServiceGroup::start()
+{
+    if (nullptr != m_localMapService)
+    {
+        return;
+    }
+
+    // Create a new local map service serving all datasets of this group
+    m_localMapService = new LocalMapService(m_templateFilePath, this);
+    m_localMapService->setDynamicWorkspaces(createWorkspaces());
+    connect(m_localMapService, &LocalMapService::statusChanged, this, [this]()
+    {
+        switch (m_localMapService->status())
+        {
+        case LocalServerStatus::Started:
+            {
+                qDebug() << "Local map server serving " << m_datasets.size() << " datasets started.";
+                m_mapImageLayer = new ArcGISMapImageLayer(m_localMapService->url(), this);
+                connect(m_mapImageLayer, &ArcGISMapImageLayer::loadStatusChanged, this, [this](LoadStatus loadStatus)
+                {
+                    switch (loadStatus)
+                    {
+                    case LoadStatus::Loaded:
+                        qDebug() << "Local map service " << m_mapImageLayer->url() << " loaded.";
+                        addSublayers(m_mapImageLayer, sublayerInfos());
+                        emit mapServiceLoaded(m_mapImageLayer);
+                        break;
+
+                    default:
+                        break;
+                    }
+                });
+                m_mapImageLayer->load();
+            }
+            break;
+
+        case LocalServerStatus::Failed:
+            qDebug() << "Local map server serving " << m_datasets.size() << " datasets failed!";
+            break;
+
+        default:
+            break;
+        }
+    });
+    m_serviceScheduler->schedule(m_scheduleKey, m_localMapService);
+}
+
+void LocalMapServiceGroup::stop()
+{
+    m_serviceScheduler->cancel(m_scheduleKey);
+    if (nullptr != m_mapImageLayer)
+    {
+        emit mapServiceRemoved(m_mapImageLayer);
+        m_mapImageLayer->deleteLater();
+        m_mapImageLayer = nullptr;
+    }
+
+    if (nullptr != m_localMapService)
+    {
+        LocalMapService *localMapService = m_localMapService;
+        m_localMapService = nullptr;
+        disconnect(localMapService, nullptr, this, nullptr);
+        // The group may be deleted before its service has stopped
+        localMapService->setParent(parent());
+        if (LocalServerStatus::Started == localMapService->status())
+        {
+            connect(localMapService, &LocalMapService::statusChanged, localMapService, [localMapService]()
+            {
+                if (LocalServerStatus::Stopped == localMapService->status())
+                {
+                    localMapService->deleteLater();
+                }
+            });
+            localMapService->stop();
+        }
+        else
+        {
+            localMapService->deleteLater();
+        }
+    }
+}
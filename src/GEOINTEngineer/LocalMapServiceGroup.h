@@ -0,0 +1,76 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef LOCALMAPSERVICEGROUP_H
+#define LOCALMAPSERVICEGROUP_H
+
+class LocalServiceScheduler;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class ArcGISMapImageLayer;
+class DynamicWorkspace;
+class LocalMapService;
+}
+}
+
+#include <QFileInfoList>
+#include <QJsonArray>
+#include <QObject>
+
+class LocalMapServiceGroup : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LocalMapServiceGroup(QString const &templateFilePath, QFileInfoList const &datasets, LocalServiceScheduler *serviceScheduler, QObject *parent = nullptr);
+
+    static void addSublayers(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer, QJsonArray const &sublayerInfos);
+
+    QFileInfoList datasets() const;
+    Esri::ArcGISRuntime::ArcGISMapImageLayer* mapImageLayer() const;
+    QJsonArray sublayerInfos() const;
+
+    void start();
+    void stop();
+
+signals:
+    void mapServiceLoaded(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
+    void mapServiceRemoved(Esri::ArcGISRuntime::ArcGISMapImageLayer *mapImageLayer);
+
+private:
+    QString workspaceId(QFileInfo const &fileInfo) const;
+    QList<Esri::ArcGISRuntime::DynamicWorkspace*> createWorkspaces();
+
+    QString m_templateFilePath;
+    QString m_scheduleKey;
+    QFileInfoList m_datasets;
+    LocalServiceScheduler *m_serviceScheduler;
+    Esri::ArcGISRuntime::LocalMapService *m_localMapService = nullptr;
+    Esri::ArcGISRuntime::ArcGISMapImageLayer *m_mapImageLayer = nullptr;
+};
+
+#endif // LOCALMAPSERVICEGROUP_H
@@ -0,0 +1,148 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalGeospatialServer.h"
+#include "LocalServiceDaemon.h"
+
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QProcessEnvironment>
+
+LocalServiceDaemon::LocalServiceDaemon(LocalGeospatialServer *geospatialServer, QObject *parent) :
+    QObject(parent),
+    m_geospatialServer(geospatialServer)
+{
+    connect(&m_localServer, &QLocalServer::newConnection, this, &LocalServiceDaemon::clientConnected);
+
+    // Every change of the running services is pushed to all attached clients,
+    // bursts of changes are published at once
+    m_publishTimer.setSingleShot(true);
+    m_publishTimer.setInterval(0);
+    connect(&m_publishTimer, &QTimer::timeout, this, qOverload<>(&LocalServiceDaemon::publishServices));
+    connect(m_geospatialServer, &LocalGeospatialServer::servicesChanged, &m_publishTimer, qOverload<>(&QTimer::start));
+    connect(m_geospatialServer, &LocalGeospatialServer::mapServiceLoaded, &m_publishTimer, qOverload<>(&QTimer::start));
+    connect(m_geospatialServer, &LocalGeospatialServer::mapServiceRemoved, &m_publishTimer, qOverload<>(&QTimer::start));
+}
+
+QString LocalServiceDaemon::serverName()
+{
+    QString serverNameKeyName = "geoint.daemon.name";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(serverNameKeyName))
+    {
+        return systemEnvironment.value(serverNameKeyName);
+    }
+
+    return "geoint-engineer-localserver";
+}
+
+bool LocalServiceDaemon::listen()
+{
+    // Only processes of the owning user may attach
+    QString serverName = LocalServiceDaemon::serverName();
+    m_localServer.setSocketOptions(QLocalServer::UserAccessOption);
+    if (m_localServer.listen(serverName))
+    {
+        qDebug() << "Local service daemon listening on" << m_localServer.fullServerName();
+        return true;
+    }
+
+    // Another daemon is already running
+    QLocalSocket probeSocket;
+    probeSocket.connectToServer(serverName);
+    if (probeSocket.waitForConnected(1000))
+    {
+        qDebug() << "Local service daemon is already running!";
+        return false;
+    }
+
+    // The socket of a crashed daemon is left behind
+    QLocalServer::removeServer(serverName);
+    if (m_localServer.listen(serverName))
+    {
+        qDebug() << "Local service daemon listening on" << m_localServer.fullServerName();
+        return true;
+    }
+
+    qDebug() << "Local service daemon cannot listen:" << m_localServer.errorString();
+    return false;
+}
+
+void LocalServiceDaemon::clientConnected()
+{
+    while (m_localServer.hasPendingConnections())
+    {
+        QLocalSocket *clientSocket = m_localServer.nextPendingConnection();
+        m_clientSockets.append(clientSocket);
+        qDebug() << "Client attached," << m_clientSockets.size() << "clients.";
+
+        connect(clientSocket, &QLocalSocket::readyRead, this, [this, clientSocket]()
+        {
+            readCommands(clientSocket);
+        });
+        connect(clientSocket, &QLocalSocket::disconnected, this, [this, clientSocket]()
+        {
+            m_clientSockets.removeOne(clientSocket);
+            clientSocket->deleteLater();
+            qDebug() << "Client detached," << m_clientSockets.size() << "clients.";
+        });
+
+        publishServices(clientSocket);
+    }
+}
+
+void LocalServiceDaemon::readCommands(QLocalSocket *clientSocket)
+{
+    // One JSON object per line
+    while (clientSocket->canReadLine())
+    {
+        QJsonObject commandObject = QJsonDocument::fromJson(clientSocket->readLine()).object();
+        QString command = commandObject["command"].toString();
+        if ("use" == command)
+        {
+            m_geospatialServer->useSharedGeoprocessingPackage(commandObject["package"].toString());
+        }
+        else
+        {
+            qDebug() << "Unknown daemon command" << command;
+        }
+    }
+}
+
+void LocalServiceDaemon::publishServices(QLocalSocket *clientSocket)
+{
+    QJsonObject servicesObject;
+    servicesObject.insert("services", m_geospatialServer->serviceDirectory());
+    clientSocket->write(QJsonDocument(servicesObject).toJson(QJsonDocument::Compact) + "\n");
+}
+
+void LocalServiceDaemon::publishServices()
+{
+    foreach (QLocalSocket *clientSocket, m_clientSockets)
+    {
+        publishServices(clientSocket);
+    }
+}
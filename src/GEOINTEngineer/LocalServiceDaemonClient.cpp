@@ -0,0 +1,134 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalServiceDaemon.h"
+#include "LocalServiceDaemonClient.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+
+LocalServiceDaemonClient::LocalServiceDaemonClient(QObject *parent) :
+    QObject(parent)
+{
+    // The local server of a launched daemon needs some time to start
+    m_retryTimer.setSingleShot(true);
+    m_retryTimer.setInterval(2000);
+    connect(&m_retryTimer, &QTimer::timeout, this, &LocalServiceDaemonClient::connectToDaemon);
+
+    connect(&m_socket, &QLocalSocket::connected, this, [this]()
+    {
+        qDebug() << "Attached to local service daemon" << m_socket.fullServerName();
+        emit attached();
+    });
+    connect(&m_socket, &QLocalSocket::disconnected, this, [this]()
+    {
+        qDebug() << "Local service daemon disconnected!";
+
+        // A crashed daemon is launched again by the next attach
+        m_daemonLaunched = false;
+        emit detached();
+    });
+    connect(&m_socket, &QLocalSocket::errorOccurred, this, &LocalServiceDaemonClient::socketError);
+    connect(&m_socket, &QLocalSocket::readyRead, this, &LocalServiceDaemonClient::readServices);
+}
+
+bool LocalServiceDaemonClient::isAttached() const
+{
+    return QLocalSocket::ConnectedState == m_socket.state();
+}
+
+void LocalServiceDaemonClient::attach()
+{
+    m_remainingRetries = 30;
+    connectToDaemon();
+}
+
+void LocalServiceDaemonClient::connectToDaemon()
+{
+    if (QLocalSocket::UnconnectedState != m_socket.state())
+    {
+        return;
+    }
+
+    m_socket.connectToServer(LocalServiceDaemon::serverName());
+}
+
+void LocalServiceDaemonClient::socketError(QLocalSocket::LocalSocketError socketError)
+{
+    switch (socketError)
+    {
+    case QLocalSocket::ServerNotFoundError:
+    case QLocalSocket::ConnectionRefusedError:
+        break;
+
+    default:
+        qDebug() << "Local service daemon error:" << m_socket.errorString();
+        return;
+    }
+
+    // Launch the daemon once and wait for it to listen
+    if (!m_daemonLaunched)
+    {
+        m_daemonLaunched = QProcess::startDetached(QCoreApplication::applicationFilePath(), QStringList() << "--daemon");
+        qDebug() << "Launching local service daemon" << (m_daemonLaunched ? "succeeded." : "failed!");
+    }
+
+    if (m_daemonLaunched && 0 < m_remainingRetries--)
+    {
+        m_retryTimer.start();
+        return;
+    }
+
+    qDebug() << "Local service daemon is not available!";
+    emit attachFailed();
+}
+
+void LocalServiceDaemonClient::readServices()
+{
+    // One JSON object per line
+    while (m_socket.canReadLine())
+    {
+        QJsonObject servicesObject = QJsonDocument::fromJson(m_socket.readLine()).object();
+        if (servicesObject.contains("services"))
+        {
+            emit servicesPublished(servicesObject["services"].toArray());
+        }
+    }
+}
+
+void LocalServiceDaemonClient::useGeoprocessingPackage(QString const &packageFilePath)
+{
+    if (!isAttached())
+    {
+        return;
+    }
+
+    QJsonObject commandObject;
+    commandObject.insert("command", "use");
+    commandObject.insert("package", packageFilePath);
+    m_socket.write(QJsonDocument(commandObject).toJson(QJsonDocument::Compact) + "\n");
+}
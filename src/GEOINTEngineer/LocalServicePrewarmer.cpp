@@ -0,0 +1,213 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalServicePrewarmer.h"
+#include "LocalGeospatialTask.h"
+
+#include "CoreTypes.h"
+#include "Envelope.h"
+#include "Feature.h"
+#include "FeatureCollectionTable.h"
+#include "Field.h"
+#include "GeometryTypes.h"
+#include "GeoprocessingFeatures.h"
+#include "GeoprocessingJob.h"
+#include "GeoprocessingParameters.h"
+#include "GeoprocessingTask.h"
+#include "PolygonBuilder.h"
+#include "SpatialReference.h"
+#include "TaskTypes.h"
+#include "TaskWatcher.h"
+
+#include <QDebug>
+
+using namespace Esri::ArcGISRuntime;
+
+LocalServicePrewarmer::LocalServicePrewarmer(QObject *parent) :
+    QObject(parent)
+{
+    // A hung synthetic job must not block the pre-warming of the other services
+    const int DefaultDeadline = 5 * 60 * 1000;
+    m_deadlineTimer.setSingleShot(true);
+    m_deadlineTimer.setInterval(DefaultDeadline);
+    connect(&m_deadlineTimer, &QTimer::timeout, this, [this]()
+    {
+        qDebug() << "Pre-warming" << m_currentRequest.taskName << "passed its deadline!";
+        finishPrewarm(false);
+    });
+}
+
+void LocalServicePrewarmer::setJobDeadline(int jobDeadlineMilliseconds)
+{
+    // Without a job deadline the default one applies
+    if (0 < jobDeadlineMilliseconds)
+    {
+        m_deadlineTimer.setInterval(jobDeadlineMilliseconds);
+    }
+}
+
+void LocalServicePrewarmer::prewarm(LocalGeospatialTask *geospatialTask)
+{
+    PrewarmRequest prewarmRequest;
+    prewarmRequest.taskName = geospatialTask->name();
+    prewarmRequest.taskUrl = geospatialTask->url();
+    prewarmRequest.inputParameterName = geospatialTask->inputFeaturesParameterName();
+    if (prewarmRequest.inputParameterName.isEmpty())
+    {
+        return;
+    }
+
+    m_pendingRequests.append(prewarmRequest);
+    if (nullptr == m_inputFeatureTable)
+    {
+        createInputFeatures();
+        return;
+    }
+
+    prewarmNext();
+}
+
+void LocalServicePrewarmer::createInputFeatures()
+{
+    // A minimal polygon built like the map extent graphic
+    Envelope boundingBox(0.0, 0.0, 0.001, 0.001, SpatialReference::wgs84());
+    PolygonBuilder polygonBuilder(boundingBox.spatialReference());
+    polygonBuilder.addPoint(boundingBox.xMin(), boundingBox.yMin());
+    polygonBuilder.addPoint(boundingBox.xMin(), boundingBox.yMax());
+    polygonBuilder.addPoint(boundingBox.xMax(), boundingBox.yMax());
+    polygonBuilder.addPoint(boundingBox.xMax(), boundingBox.yMin());
+
+    QList<Field> fields;
+    fields.append(Field::createText("Description", "Description", 0));
+    m_inputFeatureTable = new FeatureCollectionTable(fields, GeometryType::Polygon, boundingBox.spatialReference(), this);
+    connect(m_inputFeatureTable, &FeatureCollectionTable::addFeatureCompleted, this, &LocalServicePrewarmer::onInputFeatureAdded);
+
+    Feature *envelopeAsFeature = m_inputFeatureTable->createFeature(this);
+    envelopeAsFeature->setGeometry(polygonBuilder.toPolygon());
+    m_inputFeatureTable->addFeature(envelopeAsFeature);
+}
+
+void LocalServicePrewarmer::onInputFeatureAdded(QUuid, bool added)
+{
+    if (!added)
+    {
+        qDebug() << "Adding pre-warm input feature failed!";
+        m_pendingRequests.clear();
+        return;
+    }
+
+    m_inputFeatures = new GeoprocessingFeatures(m_inputFeatureTable, this);
+    m_inputFeaturesReady = true;
+    prewarmNext();
+}
+
+void LocalServicePrewarmer::prewarmNext()
+{
+    // Only one synthetic job at a time, so that analyst jobs are not slowed down
+    if (!m_inputFeaturesReady || nullptr != m_currentTask || m_pendingRequests.isEmpty())
+    {
+        return;
+    }
+
+    m_currentRequest = m_pendingRequests.takeFirst();
+    m_prewarmTimer.start();
+    m_deadlineTimer.start();
+
+    // A separate task instance keeps the synthetic results away from the analyst
+    m_currentTask = new GeoprocessingTask(m_currentRequest.taskUrl, this);
+    connect(m_currentTask, &GeoprocessingTask::createDefaultParametersCompleted, this, [this](QUuid, GeoprocessingParameters const &defaultParameters)
+    {
+        submitJob(defaultParameters);
+    });
+    connect(m_currentTask, &GeoprocessingTask::loadStatusChanged, this, [this](LoadStatus loadStatus)
+    {
+        switch (loadStatus)
+        {
+        case LoadStatus::Loaded:
+            m_currentTask->createDefaultParameters();
+            break;
+
+        case LoadStatus::FailedToLoad:
+            finishPrewarm(false);
+            break;
+
+        default:
+            break;
+        }
+    });
+    qDebug() << "Pre-warming" << m_currentRequest.taskName << "...";
+    m_currentTask->load();
+}
+
+void LocalServicePrewarmer::submitJob(GeoprocessingParameters const &defaultParameters)
+{
+    QMap<QString, GeoprocessingParameter*> inputs = defaultParameters.inputs();
+    inputs.insert(m_currentRequest.inputParameterName, m_inputFeatures);
+    GeoprocessingParameters inputParameters(defaultParameters.executionType());
+    inputParameters.setInputs(inputs);
+
+    GeoprocessingJob *prewarmJob = m_currentTask->createJob(inputParameters);
+    m_currentJob = prewarmJob;
+    connect(prewarmJob, &GeoprocessingJob::jobDone, this, [this, prewarmJob]()
+    {
+        switch (prewarmJob->jobStatus())
+        {
+        case JobStatus::Succeeded:
+            finishPrewarm(true);
+            break;
+
+        case JobStatus::Failed:
+            // Even a failed job loads the tool and its libraries
+            finishPrewarm(false);
+            break;
+
+        default:
+            break;
+        }
+    });
+    prewarmJob->start();
+}
+
+void LocalServicePrewarmer::finishPrewarm(bool succeeded)
+{
+    qint64 elapsedMilliseconds = m_prewarmTimer.elapsed();
+    qDebug() << "Pre-warming" << m_currentRequest.taskName << (succeeded ? "succeeded" : "failed") << "after" << elapsedMilliseconds << "ms.";
+    emit taskPrewarmed(m_currentRequest.taskName, elapsedMilliseconds);
+    m_deadlineTimer.stop();
+
+    // Discard the synthetic job and its results, a job still running is cancelled
+    if (nullptr != m_currentJob)
+    {
+        disconnect(m_currentJob, nullptr, this, nullptr);
+        if (JobStatus::Started == m_currentJob->jobStatus())
+        {
+            m_currentJob->cancel();
+        }
+        m_currentJob = nullptr;
+    }
+    disconnect(m_currentTask, nullptr, this, nullptr);
+    m_currentTask->deleteLater();
+    m_currentTask = nullptr;
+    prewarmNext();
+}
@@ -0,0 +1,88 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef LOCALSERVICEPREWARMER_H
+#define LOCALSERVICEPREWARMER_H
+
+class LocalGeospatialTask;
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class FeatureCollectionTable;
+class GeoprocessingFeatures;
+class GeoprocessingJob;
+class GeoprocessingParameters;
+class GeoprocessingTask;
+}
+}
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+#include <QUuid>
+
+class LocalServicePrewarmer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LocalServicePrewarmer(QObject *parent = nullptr);
+
+    void prewarm(LocalGeospatialTask *geospatialTask);
+    void setJobDeadline(int jobDeadlineMilliseconds);
+
+signals:
+    void taskPrewarmed(QString const &taskName, qint64 elapsedMilliseconds);
+
+private slots:
+    void onInputFeatureAdded(QUuid, bool added);
+
+private:
+    struct PrewarmRequest {
+        QString taskName;
+        QUrl taskUrl;
+        QString inputParameterName;
+    };
+
+    void createInputFeatures();
+    void prewarmNext();
+    void submitJob(Esri::ArcGISRuntime::GeoprocessingParameters const &defaultParameters);
+    void finishPrewarm(bool succeeded);
+
+    Esri::ArcGISRuntime::FeatureCollectionTable *m_inputFeatureTable = nullptr;
+    Esri::ArcGISRuntime::GeoprocessingFeatures *m_inputFeatures = nullptr;
+    QList<PrewarmRequest> m_pendingRequests;
+    PrewarmRequest m_currentRequest;
+    Esri::ArcGISRuntime::GeoprocessingTask *m_currentTask = nullptr;
+    Esri::ArcGISRuntime::GeoprocessingJob *m_currentJob = nullptr;
+    QElapsedTimer m_prewarmTimer;
+    QTimer m_deadlineTimer;
+    bool m_inputFeaturesReady = false;
+};
+
+#endif // LOCALSERVICEPREWARMER_H
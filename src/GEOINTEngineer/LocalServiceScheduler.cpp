@@ -0,0 +1,340 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalServiceScheduler.h"
+
+#include "CoreTypes.h"
+#include "LocalServerTypes.h"
+#include "LocalService.h"
+#include "MobileMapPackage.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcessEnvironment>
+#include <QThread>
+#include <QTimer>
+
+using namespace Esri::ArcGISRuntime;
+
+LocalServiceScheduler::LocalServiceScheduler(QObject *parent) :
+    QObject(parent),
+    m_concurrencyLimit(qMax(1, QThread::idealThreadCount() / 2))
+{
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    QString concurrencyKeyName = "geoint.startup.concurrency";
+    if (systemEnvironment.contains(concurrencyKeyName))
+    {
+        bool validLimit = false;
+        int concurrencyLimit = systemEnvironment.value(concurrencyKeyName).toInt(&validLimit);
+        if (validLimit)
+        {
+            setConcurrencyLimit(concurrencyLimit);
+        }
+    }
+
+    // Pinned packages are started first, e.g. "buffer.gpkx;hotspots.gpkx"
+    QString pinnedKeyName = "geoint.pinnedpackages";
+    if (systemEnvironment.contains(pinnedKeyName))
+    {
+        m_pinnedPackages = systemEnvironment.value(pinnedKeyName).split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    }
+
+    loadPackageUsage();
+}
+
+int LocalServiceScheduler::concurrencyLimit() const
+{
+    return m_concurrencyLimit;
+}
+
+void LocalServiceScheduler::setConcurrencyLimit(int concurrencyLimit)
+{
+    m_concurrencyLimit = qMax(1, concurrencyLimit);
+    scheduleDispatch();
+}
+
+void LocalServiceScheduler::schedule(QString const &packageFilePath, LocalService *localService)
+{
+    // Several instances of the same package are distinct requests
+    StartRequest startRequest;
+    startRequest.packageFilePath = packageFilePath;
+    startRequest.sequence = m_sequence++;
+    startRequest.context = new QObject(this);
+    startRequest.start = [localService]()
+    {
+        localService->start();
+    };
+
+    // The context is deleted when the request finishes, which disconnects the handler
+    qint64 sequence = startRequest.sequence;
+    connect(localService, &LocalService::statusChanged, startRequest.context, [this, sequence, localService]()
+    {
+        switch (localService->status())
+        {
+        case LocalServerStatus::Started:
+            finish(sequence, true);
+            break;
+
+        case LocalServerStatus::Failed:
+            finish(sequence, false);
+            break;
+
+        default:
+            break;
+        }
+    });
+    enqueue(startRequest);
+}
+
+void LocalServiceScheduler::schedule(QString const &packageFilePath, MobileMapPackage *mobileMapPackage)
+{
+    StartRequest startRequest;
+    startRequest.packageFilePath = packageFilePath;
+    startRequest.sequence = m_sequence++;
+    startRequest.context = new QObject(this);
+    startRequest.start = [mobileMapPackage]()
+    {
+        mobileMapPackage->load();
+    };
+
+    qint64 sequence = startRequest.sequence;
+    connect(mobileMapPackage, &MobileMapPackage::loadStatusChanged, startRequest.context, [this, sequence](LoadStatus loadStatus)
+    {
+        switch (loadStatus)
+        {
+        case LoadStatus::Loaded:
+            finish(sequence, true);
+            break;
+
+        case LoadStatus::FailedToLoad:
+            finish(sequence, false);
+            break;
+
+        default:
+            break;
+        }
+    });
+    enqueue(startRequest);
+}
+
+void LocalServiceScheduler::cancel(QString const &packageFilePath)
+{
+    for (int index = m_pendingRequests.size() - 1; 0 <= index; index--)
+    {
+        if (packageFilePath == m_pendingRequests[index].packageFilePath)
+        {
+            m_pendingRequests.takeAt(index).context->deleteLater();
+        }
+    }
+
+    // A removed package must not block a slot
+    bool slotReleased = false;
+    for (auto runningIterator = m_runningRequests.begin(); runningIterator != m_runningRequests.end();)
+    {
+        if (packageFilePath == runningIterator.value().packageFilePath)
+        {
+            runningIterator.value().context->deleteLater();
+            runningIterator = m_runningRequests.erase(runningIterator);
+            slotReleased = true;
+        }
+        else
+        {
+            ++runningIterator;
+        }
+    }
+    if (slotReleased)
+    {
+        scheduleDispatch();
+    }
+}
+
+void LocalServiceScheduler::recordPackageUsage(QString const &packageFilePath)
+{
+    m_packageUsage.insert(packageFilePath, QDateTime::currentDateTimeUtc());
+    savePackageUsage();
+}
+
+void LocalServiceScheduler::enqueue(StartRequest const &startRequest)
+{
+    m_pendingRequests.append(startRequest);
+    m_pendingRequests.last().queuedTimer.start();
+
+    // Defer the dispatch, so that all packages scheduled in one pass are prioritized together
+    scheduleDispatch();
+}
+
+void LocalServiceScheduler::scheduleDispatch()
+{
+    if (m_dispatchScheduled)
+    {
+        return;
+    }
+
+    m_dispatchScheduled = true;
+    QTimer::singleShot(0, this, &LocalServiceScheduler::dispatch);
+}
+
+void LocalServiceScheduler::dispatch()
+{
+    m_dispatchScheduled = false;
+    while (m_runningRequests.size() < m_concurrencyLimit && !m_pendingRequests.isEmpty())
+    {
+        int nextIndex = 0;
+        for (int index = 1, requestCount = m_pendingRequests.size(); index < requestCount; index++)
+        {
+            if (hasHigherPriority(m_pendingRequests[index], m_pendingRequests[nextIndex]))
+            {
+                nextIndex = index;
+            }
+        }
+
+        StartRequest startRequest = m_pendingRequests.takeAt(nextIndex);
+        startRequest.queuedMilliseconds = startRequest.queuedTimer.elapsed();
+        startRequest.startupTimer.start();
+        m_runningRequests.insert(startRequest.sequence, startRequest);
+        qDebug() << "Starting" << startRequest.packageFilePath << "after" << startRequest.queuedMilliseconds << "ms in queue"
+                 << "(" << m_runningRequests.size() << "/" << m_concurrencyLimit << "running," << m_pendingRequests.size() << "pending)";
+        startRequest.start();
+    }
+}
+
+void LocalServiceScheduler::finish(qint64 sequence, bool started)
+{
+    if (!m_runningRequests.contains(sequence))
+    {
+        return;
+    }
+
+    StartRequest startRequest = m_runningRequests.take(sequence);
+    startRequest.context->deleteLater();
+    QString packageFilePath = startRequest.packageFilePath;
+
+    qint64 startupMilliseconds = startRequest.startupTimer.elapsed();
+    if (started)
+    {
+        qDebug() << "Time to started for" << packageFilePath << ":" << (startRequest.queuedMilliseconds + startupMilliseconds) << "ms"
+                 << "(queued" << startRequest.queuedMilliseconds << "ms, startup" << startupMilliseconds << "ms)";
+        emit serviceStarted(packageFilePath, startRequest.queuedMilliseconds, startupMilliseconds);
+    }
+    else
+    {
+        qDebug() << "Starting" << packageFilePath << "failed after" << startupMilliseconds << "ms!";
+        emit serviceFailed(packageFilePath, startRequest.queuedMilliseconds, startupMilliseconds);
+    }
+
+    scheduleDispatch();
+}
+
+bool LocalServiceScheduler::isPinned(QString const &packageFilePath) const
+{
+    QString packageFileName = QFileInfo(packageFilePath).fileName();
+    foreach (QString const &pinnedPackage, m_pinnedPackages)
+    {
+        if (0 == pinnedPackage.compare(packageFileName, Qt::CaseInsensitive)
+                || 0 == pinnedPackage.compare(packageFilePath, Qt::CaseInsensitive))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool LocalServiceScheduler::hasHigherPriority(StartRequest const &request, StartRequest const &otherRequest) const
+{
+    // Pinned packages first
+    bool pinned = isPinned(request.packageFilePath);
+    bool otherPinned = isPinned(otherRequest.packageFilePath);
+    if (pinned != otherPinned)
+    {
+        return pinned;
+    }
+
+    // Then the most recently used packages
+    QDateTime lastUsed = m_packageUsage.value(request.packageFilePath);
+    QDateTime otherLastUsed = m_packageUsage.value(otherRequest.packageFilePath);
+    if (lastUsed != otherLastUsed)
+    {
+        if (!lastUsed.isValid())
+        {
+            return false;
+        }
+        if (!otherLastUsed.isValid())
+        {
+            return true;
+        }
+
+        return otherLastUsed < lastUsed;
+    }
+
+    // Then in the order of scheduling
+    return request.sequence < otherRequest.sequence;
+}
+
+QString LocalServiceScheduler::usageFilePath() const
+{
+    return QDir::temp().filePath("geoint-engineer-package-usage.json");
+}
+
+void LocalServiceScheduler::loadPackageUsage()
+{
+    QFile usageFile(usageFilePath());
+    if (!usageFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QJsonObject usageObject = QJsonDocument::fromJson(usageFile.readAll()).object();
+    foreach (QString const &packageFilePath, usageObject.keys())
+    {
+        QDateTime lastUsed = QDateTime::fromString(usageObject[packageFilePath].toString(), Qt::ISODate);
+        if (lastUsed.isValid())
+        {
+            m_packageUsage.insert(packageFilePath, lastUsed);
+        }
+    }
+}
+
+void LocalServiceScheduler::savePackageUsage() const
+{
+    QJsonObject usageObject;
+    for (auto usageIterator = m_packageUsage.constBegin(); usageIterator != m_packageUsage.constEnd(); ++usageIterator)
+    {
+        usageObject.insert(usageIterator.key(), usageIterator.value().toString(Qt::ISODate));
+    }
+
+    QFile usageFile(usageFilePath());
+    if (!usageFile.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot save package usage file!";
+        return;
+    }
+
+    usageFile.write(QJsonDocument(usageObject).toJson());
+    usageFile.close();
+}
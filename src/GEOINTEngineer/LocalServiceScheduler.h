@@ -0,0 +1,97 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef LOCALSERVICESCHEDULER_H
+#define LOCALSERVICESCHEDULER_H
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class LocalService;
+class MobileMapPackage;
+}
+}
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QObject>
+#include <QStringList>
+
+#include <functional>
+
+class LocalServiceScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LocalServiceScheduler(QObject *parent = nullptr);
+
+    int concurrencyLimit() const;
+    void setConcurrencyLimit(int concurrencyLimit);
+
+    void schedule(QString const &packageFilePath, Esri::ArcGISRuntime::LocalService *localService);
+    void schedule(QString const &packageFilePath, Esri::ArcGISRuntime::MobileMapPackage *mobileMapPackage);
+    void cancel(QString const &packageFilePath);
+
+    void recordPackageUsage(QString const &packageFilePath);
+
+signals:
+    void serviceStarted(QString const &packageFilePath, qint64 queuedMilliseconds, qint64 startupMilliseconds);
+    void serviceFailed(QString const &packageFilePath, qint64 queuedMilliseconds, qint64 startupMilliseconds);
+
+private:
+    struct StartRequest {
+        QString packageFilePath;
+        std::function<void()> start;
+        QObject *context = nullptr;
+        qint64 sequence = 0;
+        QElapsedTimer queuedTimer;
+        QElapsedTimer startupTimer;
+        qint64 queuedMilliseconds = 0;
+    };
+
+    void enqueue(StartRequest const &startRequest);
+    void scheduleDispatch();
+    void dispatch();
+    void finish(qint64 sequence, bool started);
+
+    bool isPinned(QString const &packageFilePath) const;
+    bool hasHigherPriority(StartRequest const &request, StartRequest const &otherRequest) const;
+
+    QString usageFilePath() const;
+    void loadPackageUsage();
+    void savePackageUsage() const;
+
+    int m_concurrencyLimit;
+    qint64 m_sequence = 0;
+    bool m_dispatchScheduled = false;
+    QList<StartRequest> m_pendingRequests;
+    QMap<qint64, StartRequest> m_runningRequests;
+    QStringList m_pinnedPackages;
+    QMap<QString, QDateTime> m_packageUsage;
+};
+
+#endif // LOCALSERVICESCHEDULER_H
@@ -0,0 +1,170 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "LocalGeoprocessingPackage.h"
+#include "LocalServiceWatchdog.h"
+
+#include "LocalGeoprocessingService.h"
+
+#include <QDebug>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QProcessEnvironment>
+#include <QUrl>
+
+using namespace Esri::ArcGISRuntime;
+
+LocalServiceWatchdog::LocalServiceWatchdog(QObject *parent) :
+    QObject(parent)
+{
+    // Health check interval in seconds, zero only reacts on failed services
+    int checkInterval = 30 * 1000;
+    QString intervalKeyName = "geoint.watchdog.interval";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(intervalKeyName))
+    {
+        checkInterval = systemEnvironment.value(intervalKeyName).toInt() * 1000;
+    }
+
+    connect(&m_checkTimer, &QTimer::timeout, this, &LocalServiceWatchdog::checkServices);
+    if (0 < checkInterval)
+    {
+        m_checkTimer.start(checkInterval);
+    }
+}
+
+int LocalServiceWatchdog::checkInterval() const
+{
+    return m_checkTimer.isActive() ? m_checkTimer.interval() : 0;
+}
+
+void LocalServiceWatchdog::watch(LocalGeoprocessingPackage *geoprocessingPackage)
+{
+    if (m_watchStates.contains(geoprocessingPackage))
+    {
+        return;
+    }
+
+    WatchState watchState;
+    watchState.restartTimer = new QTimer(this);
+    watchState.restartTimer->setSingleShot(true);
+    connect(watchState.restartTimer, &QTimer::timeout, geoprocessingPackage, [geoprocessingPackage]()
+    {
+        qDebug() << "Restarting geoprocessing package" << geoprocessingPackage->packageFilePath();
+        geoprocessingPackage->restart();
+    });
+    m_watchStates.insert(geoprocessingPackage, watchState);
+
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceFailed, this, [this, geoprocessingPackage]()
+    {
+        serviceFailed(geoprocessingPackage);
+    });
+    connect(geoprocessingPackage, &LocalGeoprocessingPackage::serviceStarted, this, [this, geoprocessingPackage]()
+    {
+        // The failures are reset after the first successful health check,
+        // without health checks a started service counts as healthy
+        WatchState &watchState = m_watchStates[geoprocessingPackage];
+        watchState.healthy = (0 == checkInterval());
+        if (watchState.healthy)
+        {
+            watchState.failureCount = 0;
+        }
+    });
+}
+
+void LocalServiceWatchdog::unwatch(LocalGeoprocessingPackage *geoprocessingPackage)
+{
+    if (!m_watchStates.contains(geoprocessingPackage))
+    {
+        return;
+    }
+
+    WatchState watchState = m_watchStates.take(geoprocessingPackage);
+    watchState.restartTimer->deleteLater();
+    disconnect(geoprocessingPackage, nullptr, this, nullptr);
+}
+
+void LocalServiceWatchdog::checkServices()
+{
+    for (auto stateIterator = m_watchStates.begin(); stateIterator != m_watchStates.end(); ++stateIterator)
+    {
+        LocalGeoprocessingPackage *geoprocessingPackage = stateIterator.key();
+        if (!geoprocessingPackage->isStarted() || stateIterator.value().checkPending)
+        {
+            continue;
+        }
+
+        // A hanging service is treated like a failed one
+        QNetworkRequest healthRequest(QUrl(geoprocessingPackage->service()->url().toString() + "?f=json"));
+        healthRequest.setTransferTimeout(m_checkTimeout);
+        QNetworkReply *healthReply = m_networkAccessManager.get(healthRequest);
+        stateIterator.value().checkPending = true;
+        connect(healthReply, &QNetworkReply::finished, this, [this, geoprocessingPackage, healthReply]()
+        {
+            healthReply->deleteLater();
+            if (!m_watchStates.contains(geoprocessingPackage))
+            {
+                return;
+            }
+
+            WatchState &watchState = m_watchStates[geoprocessingPackage];
+            watchState.checkPending = false;
+            if (QNetworkReply::NoError != healthReply->error())
+            {
+                qDebug() << "Health check of" << geoprocessingPackage->packageFilePath() << "failed:" << healthReply->errorString();
+                serviceFailed(geoprocessingPackage);
+                return;
+            }
+
+            if (!watchState.healthy)
+            {
+                watchState.healthy = true;
+                watchState.failureCount = 0;
+            }
+        });
+    }
+}
+
+void LocalServiceWatchdog::serviceFailed(LocalGeoprocessingPackage *geoprocessingPackage)
+{
+    WatchState &watchState = m_watchStates[geoprocessingPackage];
+    if (watchState.restartTimer->isActive())
+    {
+        return;
+    }
+
+    // Exponential backoff, a service failing over and over again is not hammered
+    int restartDelay = m_initialRestartDelay;
+    for (int failureIndex = 0; failureIndex < watchState.failureCount && restartDelay < m_maximumRestartDelay; failureIndex++)
+    {
+        restartDelay *= 2;
+    }
+    restartDelay = qMin(restartDelay, m_maximumRestartDelay);
+    watchState.failureCount++;
+    watchState.healthy = false;
+
+    qDebug() << "Geoprocessing package" << geoprocessingPackage->packageFilePath() << "is restarted in" << restartDelay << "ms.";
+    emit serviceUnhealthy(geoprocessingPackage);
+    watchState.restartTimer->start(restartDelay);
+}
@@ -0,0 +1,69 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef LOCALSERVICEWATCHDOG_H
+#define LOCALSERVICEWATCHDOG_H
+
+class LocalGeoprocessingPackage;
+
+#include <QMap>
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QTimer>
+
+class LocalServiceWatchdog : public QObject
+{
+    Q_OBJECT
+public:
+    explicit LocalServiceWatchdog(QObject *parent = nullptr);
+
+    void watch(LocalGeoprocessingPackage *geoprocessingPackage);
+    void unwatch(LocalGeoprocessingPackage *geoprocessingPackage);
+
+    int checkInterval() const;
+
+signals:
+    void serviceUnhealthy(LocalGeoprocessingPackage *geoprocessingPackage);
+
+private:
+    struct WatchState {
+        int failureCount = 0;
+        bool checkPending = false;
+        bool healthy = false;
+        QTimer *restartTimer = nullptr;
+    };
+
+    void checkServices();
+    void serviceFailed(LocalGeoprocessingPackage *geoprocessingPackage);
+
+    QMap<LocalGeoprocessingPackage*, WatchState> m_watchStates;
+    QNetworkAccessManager m_networkAccessManager;
+    QTimer m_checkTimer;
+    int m_checkTimeout = 10 * 1000;
+    int m_initialRestartDelay = 1000;
+    int m_maximumRestartDelay = 5 * 60 * 1000;
+};
+
+#endif // LOCALSERVICEWATCHDOG_H
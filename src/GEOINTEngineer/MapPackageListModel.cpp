@@ -0,0 +1,432 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "MapPackageListModel.h"
+
+#include "CoreTypes.h"
+#include "Envelope.h"
+#include "Item.h"
+#include "Map.h"
+#include "MobileMapPackage.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QJsonDocument>
+#include <QProcessEnvironment>
+#include <QUrl>
+
+using namespace Esri::ArcGISRuntime;
+
+MapPackageListModel::MapPackageListModel(QObject *parent) :
+    QAbstractListModel(parent)
+{
+    // Number of mobile map packages kept in memory
+    QString maximumLoadedKeyName = "geoint.maps.maxloaded";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(maximumLoadedKeyName))
+    {
+        m_maximumLoadedPackages = qMax(1, systemEnvironment.value(maximumLoadedKeyName).toInt());
+    }
+
+    loadMetadata();
+}
+
+void MapPackageListModel::addPackage(QString const &packageFilePath)
+{
+    if (-1 != findPackage(packageFilePath))
+    {
+        return;
+    }
+
+    MapPackageEntry packageEntry;
+    packageEntry.packageFilePath = packageFilePath;
+    packageEntry.name = QFileInfo(packageFilePath).completeBaseName();
+
+    // Cached metadata is only valid for the unchanged package
+    QFileInfo packageFileInfo(packageFilePath);
+    QJsonObject metadataEntry = m_metadataObject[packageFilePath].toObject();
+    if (!metadataEntry.isEmpty()
+            && metadataEntry["size"].toVariant().toLongLong() == packageFileInfo.size()
+            && metadataEntry["lastModified"].toString() == packageFileInfo.lastModified().toUTC().toString(Qt::ISODateWithMs))
+    {
+        packageEntry.name = metadataEntry["name"].toString();
+        packageEntry.extent = metadataEntry["extent"].toString();
+        packageEntry.thumbnailFilePath = metadataEntry["thumbnail"].toString();
+    }
+    else
+    {
+        m_pendingMetadata.append(packageFilePath);
+    }
+
+    beginInsertRows(QModelIndex(), rowCount(), rowCount());
+    m_packageEntries.append(packageEntry);
+    endInsertRows();
+
+    fetchNextMetadata();
+}
+
+void MapPackageListModel::removePackage(QString const &packageFilePath)
+{
+    int packageIndex = findPackage(packageFilePath);
+    if (-1 == packageIndex)
+    {
+        return;
+    }
+
+    m_pendingMetadata.removeAll(packageFilePath);
+    if (packageFilePath == m_selectedPackageFilePath
+            || packageFilePath == m_currentPackageFilePath)
+    {
+        // The maps of the selected package are still shown
+        qDebug() << "Selected mobile map package" << packageFilePath << "was removed.";
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), packageIndex, packageIndex);
+    MapPackageEntry packageEntry = m_packageEntries.takeAt(packageIndex);
+    endRemoveRows();
+
+    if (nullptr != packageEntry.mobileMapPackage)
+    {
+        packageEntry.mobileMapPackage->deleteLater();
+    }
+}
+
+void MapPackageListModel::setCurrentMap(Map *map)
+{
+    // The package owning the shown map must outlive it
+    m_currentPackageFilePath.clear();
+    foreach (MapPackageEntry const &packageEntry, m_packageEntries)
+    {
+        if (nullptr != packageEntry.mobileMapPackage
+                && packageEntry.mobileMapPackage->maps().contains(map))
+        {
+            m_currentPackageFilePath = packageEntry.packageFilePath;
+            break;
+        }
+    }
+
+    unloadPackages();
+}
+
+void MapPackageListModel::selectPackage(int packageIndex)
+{
+    if (packageIndex < 0 || m_packageEntries.size() <= packageIndex)
+    {
+        qDebug() << "Wrong index!";
+        return;
+    }
+
+    MapPackageEntry &packageEntry = m_packageEntries[packageIndex];
+    m_selectedPackageFilePath = packageEntry.packageFilePath;
+    packageEntry.lastSelected = QDateTime::currentDateTimeUtc();
+    if (nullptr != packageEntry.mobileMapPackage
+            && LoadStatus::Loaded == packageEntry.mobileMapPackage->loadStatus()
+            && !packageEntry.mobileMapPackage->maps().isEmpty())
+    {
+        emit mapSelected(packageEntry.mobileMapPackage->maps().first());
+        return;
+    }
+
+    loadPackage(packageIndex);
+}
+
+void MapPackageListModel::loadPackage(int packageIndex)
+{
+    MapPackageEntry &packageEntry = m_packageEntries[packageIndex];
+    if (nullptr != packageEntry.mobileMapPackage)
+    {
+        // Still loading
+        return;
+    }
+
+    QString packageFilePath = packageEntry.packageFilePath;
+    MobileMapPackage *mobileMapPackage = new MobileMapPackage(packageFilePath, this);
+    packageEntry.mobileMapPackage = mobileMapPackage;
+    connect(mobileMapPackage, &MobileMapPackage::loadStatusChanged, this, [this, packageFilePath, mobileMapPackage](LoadStatus loadStatus)
+    {
+        int loadedIndex = findPackage(packageFilePath);
+        switch (loadStatus)
+        {
+        case LoadStatus::Loaded:
+            qDebug() << "Local mobile map package " << packageFilePath << " loaded.";
+            if (-1 != loadedIndex)
+            {
+                emit dataChanged(index(loadedIndex), index(loadedIndex), QVector<int>() << LoadedRole);
+            }
+            if (packageFilePath == m_selectedPackageFilePath
+                    && !mobileMapPackage->maps().isEmpty())
+            {
+                emit mapSelected(mobileMapPackage->maps().first());
+            }
+            unloadPackages();
+            break;
+
+        case LoadStatus::FailedToLoad:
+            qDebug() << "Local mobile map package " << packageFilePath << " failed to load!";
+            if (-1 != loadedIndex)
+            {
+                m_packageEntries[loadedIndex].mobileMapPackage = nullptr;
+            }
+            mobileMapPackage->deleteLater();
+            break;
+
+        default:
+            break;
+        }
+    });
+    mobileMapPackage->load();
+}
+
+void MapPackageListModel::unloadPackages()
+{
+    // Release the least recently selected packages,
+    // the selected one and the one of the shown map are always kept
+    QList<int> loadedIndices;
+    for (int packageIndex = 0, packageCount = m_packageEntries.size(); packageIndex < packageCount; packageIndex++)
+    {
+        if (nullptr != m_packageEntries[packageIndex].mobileMapPackage)
+        {
+            loadedIndices.append(packageIndex);
+        }
+    }
+
+    while (m_maximumLoadedPackages < loadedIndices.size())
+    {
+        int unloadIndex = -1;
+        foreach (int loadedIndex, loadedIndices)
+        {
+            MapPackageEntry const &packageEntry = m_packageEntries[loadedIndex];
+            if (packageEntry.packageFilePath == m_selectedPackageFilePath
+                    || packageEntry.packageFilePath == m_currentPackageFilePath)
+            {
+                continue;
+            }
+            if (-1 == unloadIndex
+                    || packageEntry.lastSelected < m_packageEntries[unloadIndex].lastSelected)
+            {
+                unloadIndex = loadedIndex;
+            }
+        }
+
+        if (-1 == unloadIndex)
+        {
+            return;
+        }
+
+        MapPackageEntry &packageEntry = m_packageEntries[unloadIndex];
+        qDebug() << "Unloading mobile map package" << packageEntry.packageFilePath;
+        packageEntry.mobileMapPackage->close();
+        packageEntry.mobileMapPackage->deleteLater();
+        packageEntry.mobileMapPackage = nullptr;
+        loadedIndices.removeOne(unloadIndex);
+        emit dataChanged(index(unloadIndex), index(unloadIndex), QVector<int>() << LoadedRole);
+    }
+}
+
+void MapPackageListModel::fetchNextMetadata()
+{
+    // Metadata is read one package at a time and the package is closed afterwards
+    if (nullptr != m_metadataPackage || m_pendingMetadata.isEmpty())
+    {
+        return;
+    }
+
+    QString packageFilePath = m_pendingMetadata.takeFirst();
+    m_metadataPackage = new MobileMapPackage(packageFilePath, this);
+    connect(m_metadataPackage, &MobileMapPackage::loadStatusChanged, this, [this, packageFilePath](LoadStatus loadStatus)
+    {
+        switch (loadStatus)
+        {
+        case LoadStatus::Loaded:
+            {
+                int packageIndex = findPackage(packageFilePath);
+                if (-1 != packageIndex)
+                {
+                    readMetadata(m_packageEntries[packageIndex], m_metadataPackage);
+                    saveMetadata();
+                    emit dataChanged(index(packageIndex), index(packageIndex));
+                }
+            }
+            break;
+
+        case LoadStatus::FailedToLoad:
+            qDebug() << "Reading the metadata of" << packageFilePath << "failed!";
+            break;
+
+        default:
+            return;
+        }
+
+        m_metadataPackage->close();
+        m_metadataPackage->deleteLater();
+        m_metadataPackage = nullptr;
+        fetchNextMetadata();
+    });
+    m_metadataPackage->load();
+}
+
+void MapPackageListModel::readMetadata(MapPackageEntry &packageEntry, MobileMapPackage const *mobileMapPackage)
+{
+    Item *packageItem = mobileMapPackage->item();
+    if (nullptr == packageItem)
+    {
+        return;
+    }
+
+    if (!packageItem->title().isEmpty())
+    {
+        packageEntry.name = packageItem->title();
+    }
+
+    Envelope itemExtent = packageItem->extent();
+    if (!itemExtent.isEmpty())
+    {
+        packageEntry.extent = QString("%1, %2, %3, %4")
+                .arg(itemExtent.xMin(), 0, 'f', 4)
+                .arg(itemExtent.yMin(), 0, 'f', 4)
+                .arg(itemExtent.xMax(), 0, 'f', 4)
+                .arg(itemExtent.yMax(), 0, 'f', 4);
+    }
+
+    QImage thumbnail = packageItem->thumbnail();
+    if (!thumbnail.isNull())
+    {
+        QString thumbnailFilePath = this->thumbnailFilePath(packageEntry.packageFilePath);
+        if (thumbnail.save(thumbnailFilePath, "PNG"))
+        {
+            packageEntry.thumbnailFilePath = thumbnailFilePath;
+        }
+    }
+
+    QFileInfo packageFileInfo(packageEntry.packageFilePath);
+    QJsonObject metadataEntry;
+    metadataEntry.insert("size", QString::number(packageFileInfo.size()));
+    metadataEntry.insert("lastModified", packageFileInfo.lastModified().toUTC().toString(Qt::ISODateWithMs));
+    metadataEntry.insert("name", packageEntry.name);
+    metadataEntry.insert("extent", packageEntry.extent);
+    metadataEntry.insert("thumbnail", packageEntry.thumbnailFilePath);
+    m_metadataObject.insert(packageEntry.packageFilePath, metadataEntry);
+}
+
+int MapPackageListModel::findPackage(QString const &packageFilePath) const
+{
+    for (int packageIndex = 0, packageCount = m_packageEntries.size(); packageIndex < packageCount; packageIndex++)
+    {
+        if (packageFilePath == m_packageEntries[packageIndex].packageFilePath)
+        {
+            return packageIndex;
+        }
+    }
+
+    return -1;
+}
+
+QString MapPackageListModel::metadataFilePath() const
+{
+    return QDir::temp().filePath("geoint-engineer-map-catalog.json");
+}
+
+QString MapPackageListModel::thumbnailFilePath(QString const &packageFilePath) const
+{
+    QByteArray pathHash = QCryptographicHash::hash(packageFilePath.toUtf8(), QCryptographicHash::Sha1);
+    return QDir::temp().filePath("geoint-engineer-" + QString::fromLatin1(pathHash.toHex()) + ".png");
+}
+
+void MapPackageListModel::loadMetadata()
+{
+    QFile metadataFile(metadataFilePath());
+    if (!metadataFile.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    m_metadataObject = QJsonDocument::fromJson(metadataFile.readAll()).object();
+}
+
+void MapPackageListModel::saveMetadata() const
+{
+    QFile metadataFile(metadataFilePath());
+    if (!metadataFile.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Cannot save map catalog!";
+        return;
+    }
+
+    metadataFile.write(QJsonDocument(m_metadataObject).toJson(QJsonDocument::Compact));
+    metadataFile.close();
+}
+
+QHash<int, QByteArray> MapPackageListModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles.insert(RoleNames::NameRole, QString("name").toUtf8());
+    roles.insert(RoleNames::ExtentRole, QString("extent").toUtf8());
+    roles.insert(RoleNames::ThumbnailRole, QString("thumbnailSource").toUtf8());
+    roles.insert(RoleNames::LoadedRole, QString("loaded").toUtf8());
+    return roles;
+}
+
+int MapPackageListModel::rowCount(const QModelIndex&) const
+{
+    return m_packageEntries.size();
+}
+
+QVariant MapPackageListModel::data(const QModelIndex &index, int role) const
+{
+    if (index.row() < 0 || m_packageEntries.size() <= index.row())
+    {
+        qDebug() << "Wrong index!";
+        return QVariant();
+    }
+
+    MapPackageEntry const &packageEntry = m_packageEntries.at(index.row());
+    switch (role)
+    {
+    case NameRole:
+        return packageEntry.name;
+
+    case ExtentRole:
+        return packageEntry.extent;
+
+    case ThumbnailRole:
+        if (packageEntry.thumbnailFilePath.isEmpty())
+        {
+            return QString();
+        }
+        return QUrl::fromLocalFile(packageEntry.thumbnailFilePath).toString();
+
+    case LoadedRole:
+        return nullptr != packageEntry.mobileMapPackage
+                && LoadStatus::Loaded == packageEntry.mobileMapPackage->loadStatus();
+
+    default:
+        qDebug() << "Unknown role!";
+        return QVariant();
+    }
+}
@@ -0,0 +1,100 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+
+#ifndef MAPPACKAGELISTMODEL_H
+#define MAPPACKAGELISTMODEL_H
+
+namespace Esri
+{
+namespace ArcGISRuntime
+{
+class Map;
+class MobileMapPackage;
+}
+}
+
+#include <QAbstractListModel>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QObject>
+#include <QStringList>
+
+class MapPackageListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit MapPackageListModel(QObject *parent = nullptr);
+
+    Q_INVOKABLE void selectPackage(int packageIndex);
+
+    void addPackage(QString const &packageFilePath);
+    void removePackage(QString const &packageFilePath);
+    void setCurrentMap(Esri::ArcGISRuntime::Map *map);
+
+    QHash<int, QByteArray> roleNames() const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+signals:
+    void mapSelected(Esri::ArcGISRuntime::Map *map);
+
+private:
+    enum RoleNames {
+        NameRole = Qt::UserRole + 1,
+        ExtentRole = Qt::UserRole + 2,
+        ThumbnailRole = Qt::UserRole + 3,
+        LoadedRole = Qt::UserRole + 4
+    };
+
+    struct MapPackageEntry {
+        QString packageFilePath;
+        QString name;
+        QString extent;
+        QString thumbnailFilePath;
+        Esri::ArcGISRuntime::MobileMapPackage *mobileMapPackage = nullptr;
+        QDateTime lastSelected;
+    };
+
+    int findPackage(QString const &packageFilePath) const;
+    void loadPackage(int packageIndex);
+    void unloadPackages();
+    void readMetadata(MapPackageEntry &packageEntry, Esri::ArcGISRuntime::MobileMapPackage const *mobileMapPackage);
+    void fetchNextMetadata();
+
+    QString metadataFilePath() const;
+    QString thumbnailFilePath(QString const &packageFilePath) const;
+    void loadMetadata();
+    void saveMetadata() const;
+
+    QList<MapPackageEntry> m_packageEntries;
+    QString m_selectedPackageFilePath;
+    QString m_currentPackageFilePath;
+    QStringList m_pendingMetadata;
+    Esri::ArcGISRuntime::MobileMapPackage *m_metadataPackage = nullptr;
+    QJsonObject m_metadataObject;
+    int m_maximumLoadedPackages = 1;
+};
+
+#endif // MAPPACKAGELISTMODEL_H
@@ -0,0 +1,138 @@
+// GEOINTEngineer
+// Copyright © 2021 Esri Deutschland GmbH
+// Jan Tschada (j.tschada@esri.de)
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Additional permission under GNU LGPL version 3 section 4 and 5
+// If you modify this Program, or any covered work, by linking or combining
+// it with ArcGIS Runtime for Qt (or a modified version of that library),
+// containing parts covered by the terms of ArcGIS Runtime for Qt,
+// the licensors of this Program grant you additional permission to convey the resulting work.
+// See <https://developers.arcgis.com/qt/> for further information.
+
+#include "StartupTimeline.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMutexLocker>
+#include <QProcessEnvironment>
+#include <QTextStream>
+#include <QThread>
+
+StartupTimeline::StartupTimeline()
+{
+    m_startupTimer.start();
+}
+
+StartupTimeline* StartupTimeline::instance()
+{
+    static StartupTimeline startupTimeline;
+    return &startupTimeline;
+}
+
+void StartupTimeline::begin(QString const &stageName)
+{
+    QMutexLocker timelineLocker(&m_mutex);
+    Stage stage;
+    stage.name = stageName;
+    stage.startMilliseconds = m_startupTimer.elapsed();
+    stage.threadName = currentThreadName();
+    m_stages.append(stage);
+}
+
+void StartupTimeline::end(QString const &stageName)
+{
+    QMutexLocker timelineLocker(&m_mutex);
+    for (int index = m_stages.size() - 1; 0 <= index; index--)
+    {
+        Stage &stage = m_stages[index];
+        if (stageName == stage.name && -1 == stage.endMilliseconds)
+        {
+            stage.endMilliseconds = m_startupTimer.elapsed();
+            qDebug() << "Startup stage" << stageName << "took" << (stage.endMilliseconds - stage.startMilliseconds) << "ms.";
+            save();
+            return;
+        }
+    }
+}
+
+void StartupTimeline::mark(QString const &milestoneName)
+{
+    QMutexLocker timelineLocker(&m_mutex);
+    foreach (Stage const &stage, m_stages)
+    {
+        if (milestoneName == stage.name)
+        {
+            // Milestones are only reached once
+            return;
+        }
+    }
+
+    Stage milestone;
+    milestone.name = milestoneName;
+    milestone.startMilliseconds = m_startupTimer.elapsed();
+    milestone.endMilliseconds = milestone.startMilliseconds;
+    milestone.threadName = currentThreadName();
+    m_stages.append(milestone);
+    qDebug() << "Startup milestone" << milestoneName << "reached after" << milestone.startMilliseconds << "ms.";
+    save();
+}
+
+QString StartupTimeline::currentThreadName() const
+{
+    QCoreApplication *application = QCoreApplication::instance();
+    if (nullptr != application
+            && application->thread() == QThread::currentThread())
+    {
+        return "main";
+    }
+
+    return QString("worker-%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+}
+
+QString StartupTimeline::timelineFilePath() const
+{
+    QString pathKeyName = "geoint.timeline.path";
+    QProcessEnvironment systemEnvironment = QProcessEnvironment::systemEnvironment();
+    if (systemEnvironment.contains(pathKeyName))
+    {
+        return systemEnvironment.value(pathKeyName);
+    }
+
+    return QDir::temp().filePath("geoint-engineer-startup-timeline.csv");
+}
+
+void StartupTimeline::save() const
+{
+    QFile timelineFile(timelineFilePath());
+    if (!timelineFile.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Cannot save startup timeline!";
+        return;
+    }
+
+    // One row per stage, unfinished stages have no end
+    QTextStream timelineStream(&timelineFile);
+    timelineStream << "stage,start_ms,end_ms,thread\n";
+    foreach (Stage const &stage, m_stages)
+    {
+        timelineStream << stage.name << ","
+                       << stage.startMilliseconds << ","
+                       << (-1 == stage.endMilliseconds ? QString() : QString::number(stage.endMilliseconds)) << ","
+                       << stage.threadName << "\n";
+    }
+}
@@ -12,18 +12,25 @@
 //
 
 #include "GEOINTEngineer.h"
+#include "GeospatialJobScheduler.h"
 #include "GeospatialTaskListModel.h"
 #include "GeospatialTaskParameterModel.h"
+#include "LocalGeospatialServer.h"
 #include "LocalGeospatialTask.h"
+#include "LocalServiceDaemon.h"
+#include "MapPackageListModel.h"
+#include "StartupTimeline.h"
 
 #include "ArcGISRuntimeEnvironment.h"
 #include "MapQuickView.h"
 
+#include <QDebug>
 #include <QDir>
 #include <QGuiApplication>
 #include <QProcessEnvironment>
 #include <QQmlApplicationEngine>
 #include <QQuickStyle>
+#include <QQuickWindow>
 
 //------------------------------------------------------------------------------
 
@@ -31,6 +38,29 @@ using namespace Esri::ArcGISRuntime;
 
 int main(int argc, char *argv[])
 {
+    // The headless daemon owns the local server and keeps its services warm for all clients
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++)
+    {
+        if (0 == qstrcmp(argv[argumentIndex], "--daemon"))
+        {
+            QCoreApplication daemonApp(argc, argv);
+            LocalServiceDaemon serviceDaemon(LocalGeospatialServer::instance());
+            if (!serviceDaemon.listen())
+            {
+                return 1;
+            }
+
+            if (LocalGeospatialServer::Status::Failed == LocalGeospatialServer::instance()->start())
+            {
+                qDebug() << "Local geospatial server could not be started!";
+                return 1;
+            }
+
+            return daemonApp.exec();
+        }
+    }
+
+    StartupTimeline::instance()->begin("startup");
     QGuiApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QGuiApplication app(argc, argv);
 
@@ -52,6 +82,8 @@ int main(int argc, char *argv[])
     qmlRegisterType<GEOINTEngineer>("Esri.GEOINTEngineer", 1, 0, "GEOINTEngineer");
     qmlRegisterType<GeospatialTaskListModel>("Esri.GEOINTEngineer", 1, 0, "GeospatialTaskListModel");
     qmlRegisterUncreatableType<LocalGeospatialTask>("Esri.GEOINTEngineer", 1, 0, "LocalGeospatialTask", "Represents a local geospatial task.");
+    qmlRegisterUncreatableType<GeospatialJobScheduler>("Esri.GEOINTEngineer", 1, 0, "GeospatialJobScheduler", "Schedules the geoprocessing jobs.");
+    qmlRegisterUncreatableType<MapPackageListModel>("Esri.GEOINTEngineer", 1, 0, "MapPackageListModel", "Lists the local mobile map packages.");
     qmlRegisterType<GeospatialTaskParameterModel>("Esri.GEOINTEngineer", 1, 0, "GeospatialTaskParameterModel");
 
     // Activate the styling
@@ -67,8 +99,36 @@ int main(int argc, char *argv[])
     engine.addImportPath(ARCGIS_TOOLKIT_IMPORT_PATH_2);
 #endif
 
+    // License validation, package enumeration and the local server start
+    // run concurrently with loading the QML engine
+    switch (LocalGeospatialServer::instance()->start())
+    {
+    case LocalGeospatialServer::Status::Failed:
+        qDebug() << "Local geospatial server could not be started!";
+        break;
+
+    default:
+        break;
+    }
+
     // Set the source
+    StartupTimeline::instance()->begin("qml.load");
     engine.load(QUrl("qrc:/qml/main.qml"));
+    StartupTimeline::instance()->end("qml.load");
+
+    foreach (QObject *rootObject, engine.rootObjects())
+    {
+        QQuickWindow *rootWindow = qobject_cast<QQuickWindow*>(rootObject);
+        if (nullptr != rootWindow)
+        {
+            // The frames are swapped on the render thread, only the first queued call is delivered
+            QObject::connect(rootWindow, &QQuickWindow::frameSwapped, rootWindow, []()
+            {
+                StartupTimeline::instance()->mark("first.frame");
+            }, Qt::SingleShotConnection);
+        }
+    }
+    StartupTimeline::instance()->end("startup");
 
     return app.exec();
 }
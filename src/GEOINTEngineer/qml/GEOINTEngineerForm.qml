@@ -18,6 +18,10 @@ import Esri.GEOINTEngineer 1.0
 Item {
     id: geointForm
 
+    property alias mapPackages: model.mapPackages
+    property alias jobScheduler: model.jobScheduler
+    property alias pipelineNames: model.pipelineNames
+
     function addMapExtentAsGraphic() {
         model.addMapExtentAsGraphic();
     }
@@ -39,19 +43,32 @@ Item {
         model.deleteAllOutputFeatures();
     }
 
-    function executeTask(taskModel, taskIndex) {
-        model.executeTask(taskModel, taskIndex);
+    function executeTask(taskModel, taskIndex, parameterModel) {
+        model.executeTask(taskModel, taskIndex, parameterModel);
     }
 
     function executeAllTasks(taskModel) {
         model.executeAllTasks(taskModel);
     }
 
+    function executePipeline(pipelineName) {
+        model.executePipeline(pipelineName);
+    }
+
+    function selectTask(taskModel, taskIndex) {
+        model.selectTask(taskModel, taskIndex);
+    }
+
+    function selectMapPackage(packageIndex) {
+        model.selectMapPackage(packageIndex);
+    }
+
     function isPolygonSketchToolActivated() {
         return model.polygonSketchToolActivated;
     }
 
     signal taskLoaded(LocalGeospatialTask geospatialTask);
+    signal taskRemoved(LocalGeospatialTask geospatialTask);
 
     // Create MapQuickView here, and create its Map etc. in C++ code
     MapView {
@@ -80,5 +97,9 @@ Item {
         onTaskLoaded: {
             geointForm.taskLoaded(geospatialTask);
         }
+
+        onTaskRemoved: {
+            geointForm.taskRemoved(geospatialTask);
+        }
     }
 }
@@ -2,6 +2,7 @@ import QtQuick 2.3
 import QtQuick.Controls 2.3
 import QtQuick.Controls.Material 2.3
 import QtQuick.Layouts 1.3
+import Esri.GEOINTEngineer 1.0
 
 /*
   enum class GeoprocessingParameterType
@@ -20,9 +21,29 @@ import QtQuick.Layouts 1.3
   };
  */
 
-TextField {
-    placeholderText: model.parameterName
-    validator: RegExpValidator {
-        regExp: /.*/
+RowLayout {
+    spacing: 10
+
+    signal dateValueChanged(string valueText, int windowCount);
+
+    TextField {
+        id: dateField
+        placeholderText: qsTr("%1, date or range from/to").arg(model.parameterName)
+
+        onTextChanged: {
+            dateValueChanged(text, windowSpinBox.value);
+        }
+    }
+
+    SpinBox {
+        id: windowSpinBox
+        from: 1
+        to: GeospatialTaskParameterModel.MaximumWindowCount
+        value: 1
+        enabled: 0 <= dateField.text.indexOf("/")
+
+        onValueChanged: {
+            dateValueChanged(dateField.text, value);
+        }
     }
 }
@@ -21,7 +21,12 @@ import QtQuick.Layouts 1.3
  */
 
 TextField {
-    placeholderText: model.parameterName
-    validator: DoubleValidator {
+    placeholderText: qsTr("%1, list or range from:to:step").arg(model.parameterName)
+    inputMethodHints: Qt.ImhFormattedNumbersOnly
+
+    signal parameterValueChanged(string valueText, string unit);
+
+    onTextChanged: {
+        parameterValueChanged(text, "");
     }
 }
@@ -23,13 +23,24 @@ import QtQuick.Layouts 1.3
 RowLayout {
     spacing: 10
 
+    signal parameterValueChanged(string valueText, string unit);
+
     TextField {
-        placeholderText: model.parameterName
-        validator: DoubleValidator {
+        id: valueField
+        placeholderText: qsTr("%1, list or range from:to:step").arg(model.parameterName)
+        inputMethodHints: Qt.ImhFormattedNumbersOnly
+
+        onTextChanged: {
+            parameterValueChanged(text, unitComboBox.currentText);
         }
     }
 
     ComboBox {
+        id: unitComboBox
+        onCurrentTextChanged: {
+            parameterValueChanged(valueField.text, currentText);
+        }
+
         model: ListModel {
             ListElement {
                 text: "KM"
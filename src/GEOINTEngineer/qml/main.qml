@@ -76,6 +76,54 @@ ApplicationWindow {
                 }
             }
 
+            ComboBox {
+                id: mapPackageComboBox
+                Layout.preferredWidth: 250
+                model: engineerForm.mapPackages
+                textRole: "name"
+                displayText: -1 === currentIndex ? qsTr("Select map") : currentText
+                currentIndex: -1
+                visible: 0 < count
+
+                delegate: ItemDelegate {
+                    width: mapPackageComboBox.width
+                    contentItem: RowLayout {
+                        spacing: 10
+
+                        Image {
+                            Layout.preferredWidth: 48
+                            Layout.preferredHeight: 32
+                            fillMode: Image.PreserveAspectFit
+                            source: model.thumbnailSource
+                            asynchronous: true
+                        }
+
+                        Label {
+                            Layout.fillWidth: true
+                            text: model.name
+                            elide: Text.ElideRight
+                        }
+                    }
+                }
+
+                onActivated: {
+                    engineerForm.selectMapPackage(index);
+                }
+            }
+
+            ComboBox {
+                id: pipelineComboBox
+                Layout.preferredWidth: 200
+                model: engineerForm.pipelineNames
+                displayText: qsTr("Run pipeline")
+                currentIndex: -1
+                visible: 0 < count
+
+                onActivated: {
+                    engineerForm.executePipeline(textAt(index));
+                }
+            }
+
             Item {
                 Layout.fillWidth: true
             }
@@ -112,6 +160,16 @@ ApplicationWindow {
 
                         gpTaskListModel.addTask(geospatialTask);
                     }
+
+                    onTaskRemoved: {
+                        gpTaskListModel.removeTask(geospatialTask);
+                        if (0 < gpTaskListModel.rowCount()) {
+                            stackLayout.currentIndex = Math.min(stackLayout.currentIndex, gpTaskListModel.rowCount() - 1);
+                            gpTaskParameterModel.updateParameters(gpTaskListModel.task(stackLayout.currentIndex));
+                        } else {
+                            gpTaskParameterModel.updateParameters(null);
+                        }
+                    }
                 }
 
                 ListModel {
@@ -169,6 +227,10 @@ ApplicationWindow {
                 StackLayout {
                     id: stackLayout
 
+                    onCurrentIndexChanged: {
+                        engineerForm.selectTask(gpTaskListModel, currentIndex);
+                    }
+
                     Repeater {
                         id: gpTaskRepeater
                         model: gpTaskListModel
@@ -194,6 +256,13 @@ ApplicationWindow {
                                 font.italic: true
                             }
 
+                            Label {
+                                id: executionPolicyLabel
+                                text: model.executionPolicy
+                                Layout.fillWidth: true
+                                wrapMode: Text.WordWrap
+                            }
+
                             ScrollView {
                                 Layout.fillHeight: true
                                 Layout.fillWidth: true
@@ -223,6 +292,15 @@ ApplicationWindow {
 
                                         Connections {
                                             target: uiEditorLoader.item
+                                            ignoreUnknownSignals: true
+
+                                            function onParameterValueChanged(valueText, unit) {
+                                                gpTaskParameterModel.setParameterValue(index, valueText, unit);
+                                            }
+
+                                            function onDateValueChanged(valueText, windowCount) {
+                                                gpTaskParameterModel.setDateValue(index, valueText, windowCount);
+                                            }
 
                                             function onAddMapExtentGraphic() {
                                                 engineerForm.addMapExtentAsGraphic();
@@ -250,7 +328,7 @@ ApplicationWindow {
 
                     text: qsTr("Execute")
                     onClicked: {
-                        engineerForm.executeTask(gpTaskListModel, stackLayout.currentIndex);
+                        engineerForm.executeTask(gpTaskListModel, stackLayout.currentIndex, gpTaskParameterModel);
                     }
                 }
 
@@ -266,5 +344,14 @@ ApplicationWindow {
         Button {
             text: qsTr("Status")
         }
+
+        Label {
+            leftPadding: 15
+            verticalAlignment: Text.AlignVCenter
+            text: null === engineerForm.jobScheduler ? "" : qsTr("Jobs running: %1 queued: %2 average wait: %3 ms")
+                  .arg(engineerForm.jobScheduler.runningJobCount)
+                  .arg(engineerForm.jobScheduler.queueDepth)
+                  .arg(engineerForm.jobScheduler.averageWaitTime)
+        }
     }
 }